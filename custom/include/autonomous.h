@@ -1,4 +1,11 @@
 // Format: returnType functionName();
 
 void exampleAuton();
-void exampleAuton2();
\ No newline at end of file
+void exampleAuton2();
+
+// Actions for the bytecode routines (see auton-script.h)
+void intakeIn();
+void intakeOut();
+void intakeStop();
+void scraperDown();
+void scraperUp();
@@ -17,6 +17,7 @@ extern motor_group right_chassis;
 extern inertial inertial_sensor;
 extern rotation horizontal_tracker;
 extern rotation vertical_tracker;
+extern rotation right_vertical_tracker;
 
 extern motor intake1;
 extern motor intake2;
@@ -32,12 +33,19 @@ extern double heading_correction_kp, heading_correction_ki, heading_correction_k
 
 extern bool using_horizontal_tracker;
 extern bool using_vertical_tracker;
+extern bool using_parallel_trackers;
 extern double horizontal_tracker_dist_from_center;
 extern double vertical_tracker_dist_from_center;
 extern double horizontal_tracker_diameter;
 extern double vertical_tracker_diameter;
+extern double right_vertical_tracker_dist_from_center;
+extern double right_vertical_tracker_diameter;
+extern double tracker_heading_weight;
+extern int odom_substeps;
 
 extern bool heading_correction;
+extern bool drive_line_following;
+extern double line_lookahead_in;
 extern bool dir_change_start;
 extern bool dir_change_end;
 extern double min_output;
@@ -46,6 +54,32 @@ extern double max_slew_decel_fwd;
 extern double max_slew_accel_rev;
 extern double max_slew_decel_rev;
 extern double chase_power;
+extern double max_chassis_velocity;
+extern double max_chassis_accel;
+extern double max_lateral_accel;
+extern double inertial_scale;
+extern bool battery_compensation;
+extern double battery_reference_voltage;
+extern double battery_filter_sec;
+extern bool thermal_governor;
+extern double governor_derate_temp;
+extern double governor_start_headroom;
+extern double governor_min_scale;
+extern bool governor_report;
+extern bool slip_detection;
+extern double slip_velocity_threshold;
+extern double traction_slip_scale;
+extern double stall_velocity_rpm;
+extern double stall_current_amp;
+extern double stall_grace_msec;
+extern double contact_jerk;
+extern double front_bumper_in;
+extern double back_bumper_in;
+extern double square_voltage;
+extern bool tuning_console;
+extern double tuning_turn_deg;
+extern double tuning_drive_in;
+extern int auton_script;
 
 /**
  * Used to initialize code/tasks/devices added using tools in VEXcode Pro.
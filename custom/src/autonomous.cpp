@@ -35,6 +35,31 @@ void exampleAuton2() {
   turnToAngle(180, 800, true);
 }
 
+// Actions registered with addScriptAction so bytecode routines can run and trigger them
+
+void intakeIn() {
+  intake1.spin(fwd, 12, volt);
+  intake2.spin(fwd, 12, volt);
+}
+
+void intakeOut() {
+  intake1.spin(reverse, 12, volt);
+  intake2.spin(reverse, 12, volt);
+}
+
+void intakeStop() {
+  intake1.stop(coast);
+  intake2.stop(coast);
+}
+
+void scraperDown() {
+  scraper.set(true);
+}
+
+void scraperUp() {
+  scraper.set(false);
+}
+
 /*
  * rushClamp
  * Waits until the clamp distance sensor detects an object within 85mm, then closes the claw and lowers the rush arm.
@@ -32,6 +32,8 @@ inertial inertial_sensor = inertial(PORT9);
 // just set these to random ports if you don't use tracking wheels
 rotation horizontal_tracker = rotation(PORT13, true);
 rotation vertical_tracker = rotation(PORT19, true);
+// second vertical tracker, only used with using_parallel_trackers
+rotation right_vertical_tracker = rotation(PORT18, false);
 
 // game specific devices for high stakes
 motor intake1 = motor(PORT8, ratio6_1, true);
@@ -60,6 +62,7 @@ double heading_correction_kp = 0.6, heading_correction_ki = 0, heading_correctio
 // Enable or disable the use of tracking wheels
 bool using_horizontal_tracker = false;  // Set to true if a horizontal tracking wheel is installed and used for odometry
 bool using_vertical_tracker = false;   // Set to true if a vertical tracking wheel is installed and used for odometry
+bool using_parallel_trackers = false;  // Set to true if two parallel vertical tracking wheels (vertical_tracker and right_vertical_tracker) are installed
 
 // IGNORE THESE IF YOU ARE NOT USING TRACKING WHEELS
 // These comments are in the perspective of a top down view of the robot when the robot is facing vertical
@@ -70,12 +73,28 @@ double vertical_tracker_dist_from_center = -0.03125;
 double horizontal_tracker_diameter = 1.975; // Diameter of the horizontal tracker wheel (in inches)
 double vertical_tracker_diameter = 1.975; // Diameter of the vertical tracker wheel (in inches)
 
+// IGNORE THESE IF YOU ARE NOT USING PARALLEL TRACKING WHEELS
+// vertical_tracker is the left wheel and uses the settings above
+// Horizontal distance from the center of the bot to the right vertical tracking wheel (in inches, positive is to the right)
+double right_vertical_tracker_dist_from_center = 5;
+double right_vertical_tracker_diameter = 1.975; // Diameter of the right vertical tracker wheel (in inches)
+// Weight of the wheel heading against the inertial heading every 10 msec (1 = wheels only, 0 = inertial only)
+double tracker_heading_weight = 0.98;
+
+// Odometry samples per 10 msec; more samples follow fast turns more closely at the cost of CPU time
+int odom_substeps = 1;
+
 // ============================================================================
 // ADVANCED TUNING (OPTIONAL)
 // ============================================================================
 
 bool heading_correction = true; // Use heading correction when the bot is stationary
 
+// driveTo follows the field-frame line from its start position along correct_angle using odometry,
+// steering back toward the point line_lookahead_in inches ahead on the line when pushed sideways
+bool drive_line_following = false;
+double line_lookahead_in = 12;
+
 // Set to true for more accuracy and smoothness, false for more speed
 bool dir_change_start = true;   // Less accel/decel due to expecting direction change at start of movement
 bool dir_change_end = true;     // Less accel/decel due to expecting direction change at end of movement
@@ -93,6 +112,72 @@ double max_slew_decel_rev = 24;
 // Increase for more speed during boomerang
 double chase_power = 2;
 
+// Drive limits used to plan trajectory velocities (followTrajectory)
+// max_chassis_velocity: free speed of the wheels (motor rpm / 60 * wheel_distance_in), in inches per second
+// max_chassis_accel: Maximum forward acceleration, in inches per second squared
+// max_lateral_accel: Maximum sideways acceleration in curves before the wheels slip, in inches per second squared
+double max_chassis_velocity = 600.0 / 60.0 * (36.0 / 48.0) * 3.17 * M_PI;
+double max_chassis_accel = 150;
+double max_lateral_accel = 120;
+
+// Inertial sensor scale factor, measured with calibrateHeadingScale (true rotation / reported rotation)
+double inertial_scale = 1.0;
+
+// Battery voltage compensation: motor outputs are rescaled so they act as they would at
+// battery_reference_voltage (the voltage the PIDs were tuned at), whatever the battery is at.
+// battery_filter_sec smooths the battery reading so load sag doesn't feed back into the outputs.
+bool battery_compensation = true;
+double battery_reference_voltage = 12.8;
+double battery_filter_sec = 1.0;
+
+// Thermal governor: caps chassis output as the drive motors approach firmware derating
+// governor_derate_temp: Motor temperature where the V5 firmware starts limiting current (in degrees Celsius)
+// governor_start_headroom: Predicted headroom where the cap starts (in degrees Celsius)
+// governor_min_scale: Output fraction left at zero headroom
+// governor_report: Shows the headroom and output scale on the controller screen
+bool thermal_governor = true;
+double governor_derate_temp = 55;
+double governor_start_headroom = 10;
+double governor_min_scale = 0.6;
+bool governor_report = false;
+
+// Wheel-slip detection: drive encoder velocity is compared with the tracking wheels, or without
+// a forward tracking wheel with the inertial sensor's forward (y axis) acceleration
+// slip_velocity_threshold: Velocity gap that counts as slip (in inches per second)
+// traction_slip_scale: Output fraction while slipping (traction control)
+bool slip_detection = true;
+double slip_velocity_threshold = 8;
+double traction_slip_scale = 0.7;
+
+// Contact detection for driveUntilStalled/driveUntilContact
+// stall_velocity_rpm: Drive speed below which the robot counts as stopped (in rpm)
+// stall_current_amp: Average drive motor current that means the robot is pushing (in amps)
+// stall_grace_msec: Time allowed to get moving before a stall can be detected (in milliseconds)
+// contact_jerk: Drop in forward acceleration that means an impact (in g per second)
+double stall_velocity_rpm = 30;
+double stall_current_amp = 1.5;
+double stall_grace_msec = 150;
+double contact_jerk = 60;
+
+// Wall squaring (squareToWall)
+// front_bumper_in/back_bumper_in: Distance from the tracking center to the front/back bumper (in inches)
+// square_voltage: Voltage used to drive into the wall and hold the robot flat against it
+double front_bumper_in = 7.5;
+double back_bumper_in = 7.5;
+double square_voltage = 4;
+
+// Live tuning console (tuning.h): set tunables over USB serial or from the controller and rerun a test motion
+// tuning_console: Starts the console in pre-auton. While on, the controller arrows, L1/L2, A, B and X belong to it:
+//   up/down pick a tunable, left/right change it, L1/L2 change the step, A runs the test, B switches it, X saves
+// tuning_turn_deg/tuning_drive_in: Size of the test turn and test drive
+bool tuning_console = false;
+double tuning_turn_deg = 90;
+double tuning_drive_in = 24;
+
+// Bytecode autonomous (auton-script.h)
+// auton_script: Routine in autons.bin (in file order) that runAutonomous runs instead of auton_selected, -1 for none
+int auton_script = -1;
+
 // ============================================================================
 // DO NOT CHANGE ANYTHING BELOW
 // ============================================================================
@@ -1,10 +1,24 @@
 #include "vex.h"
 #include "motor-control.h"
+#include "mechanism.h"
+#include "triggers.h"
+#include "localization.h"
+#include "heading.h"
+#include "governor.h"
+#include "calibration.h"
+#include "config-store.h"
+#include "tuning.h"
+#include "auton-script.h"
 #include "../custom/include/autonomous.h"
 
 // Modify autonomous, driver, or pre-auton code below
 
 void runAutonomous() {
+  // a routine from autons.bin on the SD card, picked with auton_script (e.g. in config.ini), replaces the compiled ones
+  if (runScript(auton_script)) {
+    return;
+  }
+
   int auton_selected = 2;
   switch(auton_selected) {
     case 1:
@@ -66,7 +80,10 @@ void runDriver() {
     double turn = ch1 * 0.12;
 
 
-    driveChassis(forward + turn, forward - turn);
+    // a motion primitive (e.g. a tuning console test) owns the chassis while it runs
+    if (!is_turning) {
+      driveChassis(forward + turn, forward - turn);
+    }
 
     
     //test change for source control
@@ -79,6 +96,17 @@ void runDriver() {
 void runPreAutonomous() {
     // Initializing Robot Configuration. DO NOT REMOVE!
   vexcodeInit();
+
+  // tunables from config.ini on the SD card, then the geometry saved by calibrateGeometry, if any.
+  // Each load restarts the error count, so it is shown after each one.
+  if (loadConfig() && getConfigErrors() > 0) {
+    Brain.Screen.print(CONFIG_FILE ": %d bad lines skipped", getConfigErrors());
+    Brain.Screen.newLine();
+  }
+  if (loadGeometry() && getConfigErrors() > 0) {
+    Brain.Screen.print(GEOMETRY_FILE ": %d bad lines skipped", getConfigErrors());
+    Brain.Screen.newLine();
+  }
   
   // Calibrate inertial sensor
   inertial_sensor.calibrate();
@@ -90,10 +118,15 @@ void runPreAutonomous() {
 
   double current_heading = inertial_sensor.heading();
   Brain.Screen.print(current_heading);
+
+  // corrected heading, estimates gyro bias while the chassis is still
+  thread heading_task = thread(headingLoop);
   
   // odom tracking
   resetChassis();
-  if(using_horizontal_tracker && using_vertical_tracker) {
+  if(using_parallel_trackers) {
+    thread odom = thread(trackParallelOdomWheel);
+  } else if(using_horizontal_tracker && using_vertical_tracker) {
     thread odom = thread(trackXYOdomWheel);
   } else if (using_horizontal_tracker) {
     thread odom = thread(trackXOdomWheel);
@@ -102,4 +135,40 @@ void runPreAutonomous() {
   } else {
     thread odom = thread(trackNoOdomWheel);
   }
+
+  // mechanism control, one task for every registered Mechanism
+  thread mechanism_task = thread(mechanismControlLoop);
+
+  // actions the bytecode routines can run, then the routines themselves (register mechanisms before this)
+  addScriptAction("intake_in", intakeIn);
+  addScriptAction("intake_out", intakeOut);
+  addScriptAction("intake_stop", intakeStop);
+  addScriptAction("scraper_down", scraperDown);
+  addScriptAction("scraper_up", scraperUp);
+  if (!loadScripts() && auton_script >= 0) {
+    Brain.Screen.newLine();
+    Brain.Screen.print("autons.bin: %s", getScriptError());
+  }
+
+  // autonomous triggers, one task evaluates every condition -> action pair
+  thread trigger_task = thread(triggerLoop);
+
+  // particle filter localization, idle until sensors are added and it is enabled
+  thread localization_task = thread(localizationLoop);
+
+  // thermal governor, caps chassis output before the motors derate
+  addGovernedMotor(left_chassis1, true);
+  addGovernedMotor(left_chassis2, true);
+  addGovernedMotor(left_chassis3, true);
+  addGovernedMotor(right_chassis1, true);
+  addGovernedMotor(right_chassis2, true);
+  addGovernedMotor(right_chassis3, true);
+  addGovernedMotor(intake1, false);
+  addGovernedMotor(intake2, false);
+  thread governor_task = thread(governorLoop);
+
+  // live tuning console over USB serial and the controller
+  if (tuning_console) {
+    thread tuning_task = thread(tuningLoop);
+  }
 }
\ No newline at end of file
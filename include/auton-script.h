@@ -0,0 +1,54 @@
+#ifndef __AUTON_SCRIPT__
+#define __AUTON_SCRIPT__
+
+#include "script-format.h"
+
+//declarations for the autonomous bytecode interpreter.
+//Routines are compiled on the host (tools/), copied to the SD card and loaded in pre-auton,
+//so changing a waypoint needs no rebuild. See script-format.h for the file layout.
+//
+// Example:
+//   addScriptAction("intake_in", intakeIn);   // before loadScripts
+//   loadScripts();                            // in runPreAutonomous
+//   runScript(findScript("redGoalRush"));     // in runAutonomous
+
+// Default routine file on the SD card.
+#define SCRIPT_FILE "autons.bin"
+
+// Limits of the loaded routines.
+#define MAX_SCRIPT_ROUTINES 16
+#define MAX_SCRIPT_INSTRUCTIONS 512
+#define MAX_SCRIPT_ACTIONS 32
+
+// Register a named action (mechanism command, piston, ...) routines can run or trigger.
+// Returns false if all action slots are in use.
+bool addScriptAction(const char* name, void (*action)());
+
+/*
+ * loadScripts
+ * Reads a routine file and checks every instruction: known opcode, argument count and
+ * kinds, and that its actions are registered and its mechanisms exist. Routines are only
+ * kept if the whole file is valid; getScriptError tells why it was not.
+ * Returns false if there is no SD card, no file or the file is invalid.
+ */
+bool loadScripts(const char* file = SCRIPT_FILE);
+
+// Why the last loadScripts failed, "" if it did not.
+const char* getScriptError();
+
+// Loaded routines, in file order.
+int getScriptCount();
+const char* getScriptName(int index);
+
+// Routine index by name, -1 if there is none.
+int findScript(const char* name);
+
+// Runs a loaded routine to its end. Returns false if there is no such routine.
+bool runScript(int index);
+
+// Instructions in a loaded routine, and one of them run on its own (for stepping through a
+// routine or timing it step by step, see tools/autonc). Returns false past the end.
+int getScriptLength(int index);
+bool runScriptStep(int index, int step);
+
+#endif
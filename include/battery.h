@@ -0,0 +1,23 @@
+#ifndef __BATTERY__
+#define __BATTERY__
+
+//declarations for battery voltage compensation of motor outputs.
+
+// Battery voltage (in volts), low-pass filtered over battery_filter_sec.
+double getBatteryVoltage();
+
+// Factor that rescales an output from battery_reference_voltage to the actual battery,
+// 1 when battery_compensation is off or there is no battery reading.
+double getBatteryScale();
+
+/*
+ * compensateVoltage
+ * Rescales a motor output from battery_reference_voltage to the actual battery, so the
+ * same output gives the same speed on a full and a drained battery.
+ * Returns the output unchanged when battery_compensation is off. Clips to +/-12 volts;
+ * outputs that have to keep their ratio (the two chassis sides) share one getBatteryScale instead.
+ * - volts: Output the controller asks for (in volts, +/-12).
+ */
+double compensateVoltage(double volts);
+
+#endif
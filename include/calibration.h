@@ -0,0 +1,76 @@
+#ifndef __CALIBRATION__
+#define __CALIBRATION__
+
+//declarations for automatic calibration of the drive and tracking wheel geometry.
+//The fit (GeometryFit, solveGeometry) only does arithmetic on recorded sensor travel,
+//so it can be fed simulated data on a computer as well as real data on the robot.
+
+// File on the SD card the calibration is saved to and loaded from at startup.
+#define GEOMETRY_FILE "geometry.ini"
+
+// Geometry constants from robot-config.cpp that the calibration solves for.
+struct GeometryCalibration {
+  double wheel_distance_in, distance_between_wheels;
+  double vertical_tracker_diameter, right_vertical_tracker_diameter;
+  double vertical_tracker_dist_from_center, horizontal_tracker_dist_from_center, right_vertical_tracker_dist_from_center;
+};
+
+// Raw sensor travel over one stretch of a calibration run.
+struct CalibrationStep {
+  double delta_heading_rad; // Heading change (radians, clockwise positive)
+  double left_deg, right_deg; // Drive encoders (degrees)
+  double vertical_deg, horizontal_deg, right_vertical_deg; // Tracking wheels (degrees)
+};
+
+// Least-squares sums, one slot per sensor (left, right, vertical, horizontal, right vertical).
+struct GeometryFit {
+  double straight_dd[5], straight_td[5]; // Straight runs: sensor travel squared, true travel * sensor travel
+  double spin_hh, spin_hd[5];            // Spins: heading change squared, heading change * sensor travel
+  int straight_runs, spin_steps;
+};
+
+// Empties the sums.
+void clearGeometryFit(GeometryFit& fit);
+
+// Adds a straight run of known length: the whole run's sensor travel against travel_in (in inches).
+void addStraightRun(GeometryFit& fit, double travel_in, const CalibrationStep& run);
+
+// Adds one step of a spin in place.
+void addSpinStep(GeometryFit& fit, const CalibrationStep& step);
+
+/*
+ * solveGeometry
+ * Solves the geometry from the sums. Straight runs give the inches per degree of each wheel
+ * (so the wheel and tracker diameters); spins in place give how far each wheel moves per
+ * radian, which with those scales gives the drive width and each tracker's offset.
+ * Fields without data (no tracker installed, no straight run) keep the values in geometry.
+ * The horizontal tracker's diameter can't be separated from its offset this way and is kept.
+ * Returns false if there are no spins.
+ */
+bool solveGeometry(const GeometryFit& fit, GeometryCalibration& geometry);
+
+// Current geometry from robot-config.cpp.
+GeometryCalibration currentGeometry();
+
+// Writes the geometry into the robot-config.cpp globals.
+void applyGeometry(const GeometryCalibration& geometry);
+
+// Saves the geometry globals to GEOMETRY_FILE (a configuration file, see config-store.h). Returns false without an SD card.
+bool saveGeometry();
+
+// Loads GEOMETRY_FILE into the globals, call before odometry starts. Returns false if there is no file.
+bool loadGeometry();
+
+/*
+ * calibrateGeometry
+ * Guided calibration. Start with the robot's back squared against a wall and a clear
+ * straight line of wall_gap_in to the opposite wall. The robot drives wall to wall
+ * straight_runs times each way, spins in place rotations times each way, then solves,
+ * applies and saves the geometry and shows it on the Brain screen.
+ * - wall_gap_in: Distance between the two walls (in inches).
+ * - straight_runs: Round trips between the walls.
+ * - rotations: Full rotations per spin direction.
+ */
+bool calibrateGeometry(double wall_gap_in, int straight_runs = 2, int rotations = 3);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef __CONFIG_STORE__
+#define __CONFIG_STORE__
+
+//declarations for the runtime configuration store.
+//Tunables from robot-config.cpp are registered by name and can be set from an INI-like
+//file on the SD card at startup (or at runtime by the tuning console) without a rebuild.
+
+// Default configuration file on the SD card.
+#define CONFIG_FILE "config.ini"
+
+enum ConfigType { config_double, config_int, config_bool };
+
+// A registered tunable: the global it sets and the range a new value must fall in.
+struct ConfigEntry {
+  const char* name;
+  ConfigType type;
+  void* value;
+  double min, max;
+};
+
+// Number of registered tunables and the tunable at index.
+int getConfigCount();
+const ConfigEntry& getConfigEntry(int index);
+
+// Tunable by name, 0 if there is none.
+const ConfigEntry* findConfig(const char* name);
+
+// Current value of a tunable (bools as 0 or 1).
+double getConfigValue(const ConfigEntry& entry);
+
+// Parses a value as loadConfig does: a number, or true/false for bools. Returns false if it is neither.
+bool parseConfigValue(const ConfigEntry& entry, const char* text, double& value);
+
+// Sets a tunable if the value is in range (and whole for ints). Returns false otherwise.
+bool setConfigValue(const ConfigEntry& entry, double value);
+
+/*
+ * loadConfig
+ * Reads a configuration file into the registered globals. The file holds name = value lines
+ * ('#' starts a comment). Lines before any [section] always apply; a [name] section applies
+ * when name is the active profile, after the base lines. The active profile is the argument,
+ * or else the base line profile = name. Bools are true/false or 1/0.
+ * Every line is parsed and validated before any global changes; bad lines are skipped and
+ * counted (see getConfigErrors), the rest still apply.
+ * Returns false if there is no SD card or no file.
+ */
+bool loadConfig(const char* file = CONFIG_FILE, const char* profile = 0);
+
+// Lines skipped by the last loadConfig (unknown name, bad value or out of range).
+int getConfigErrors();
+
+// Writes name = value lines for the listed tunables (all of them when names is 0).
+bool saveConfig(const char* file = CONFIG_FILE, const char* const* names = 0, int name_count = 0);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef __FASTMATH__
+#define __FASTMATH__
+
+//declarations for polynomial approximations of the trig functions used every
+//control tick by odometry and the motion primitives.
+
+#include <cmath>
+
+// Maximum absolute error against libm (angles within +/-50 rad):
+//   fastSin/fastCos     double: 1e-11      float: 4e-6
+//   fastAtan2 (radians) double: 5e-10      float: 1e-5
+//   fastHypot           exact up to rounding (no overflow-safe scaling)
+double fastSin(double x);
+double fastCos(double x);
+double fastAtan2(double y, double x);
+double fastHypot(double x, double y);
+
+float fastSin(float x);
+float fastCos(float x);
+float fastAtan2(float y, float x);
+float fastHypot(float x, float y);
+
+// Trig used by odometry and the motion primitives. Build with
+// FAST_MATH = 1 in the makefile to switch them to the approximations.
+#ifdef FAST_MATH
+inline double controlSin(double x) { return fastSin(x); }
+inline double controlCos(double x) { return fastCos(x); }
+inline double controlAtan2(double y, double x) { return fastAtan2(y, x); }
+inline double controlHypot(double x, double y) { return fastHypot(x, y); }
+inline float controlSin(float x) { return fastSin(x); }
+inline float controlCos(float x) { return fastCos(x); }
+inline float controlAtan2(float y, float x) { return fastAtan2(y, x); }
+inline float controlHypot(float x, float y) { return fastHypot(x, y); }
+#else
+inline double controlSin(double x) { return sin(x); }
+inline double controlCos(double x) { return cos(x); }
+inline double controlAtan2(double y, double x) { return atan2(y, x); }
+inline double controlHypot(double x, double y) { return hypot(x, y); }
+inline float controlSin(float x) { return sinf(x); }
+inline float controlCos(float x) { return cosf(x); }
+inline float controlAtan2(float y, float x) { return atan2f(y, x); }
+inline float controlHypot(float x, float y) { return hypotf(x, y); }
+#endif
+
+#endif
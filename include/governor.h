@@ -0,0 +1,27 @@
+#ifndef __GOVERNOR__
+#define __GOVERNOR__
+
+//declarations for the thermal output governor.
+//Models each motor's temperature and caps chassis output before the V5 firmware derates the motors.
+
+// Number of motors the governor can watch.
+#define MAX_GOVERNED_MOTORS 8
+
+// Register a motor. Chassis motors set the output cap; the others are only reported.
+void addGovernedMotor(vex::motor& motor, bool chassis);
+
+// Fraction of full output the chassis may use (governor_min_scale to 1).
+// Caps the voltage driveChassis sends (after battery compensation) and the acceleration
+// slew limits of driving primitives; deceleration is not slowed.
+double getGovernorScale();
+
+// Predicted thermal headroom of the hottest motor (in degrees Celsius before derating).
+double getGovernorMargin();
+
+// Predicted headroom of one motor, in registration order.
+double getMotorHeadroom(int index);
+
+// Samples temperature, current and power of every registered motor every 100 msec.
+void governorLoop();
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef __HEADING__
+#define __HEADING__
+
+//declarations for the corrected inertial heading (bias and scale factor).
+
+// Heading in degrees with the gyro bias removed and inertial_scale applied, up to date at
+// every call (not only at headingLoop's 10 msec samples), so odometry sub-steps see each turn.
+// Falls back to the raw inertial rotation until headingLoop has started.
+double getCorrectedHeading();
+
+// Sets the corrected heading (in degrees). While odometry runs use resetOdometryHeading
+// (motor-control.h), which also tells the tracker.
+void setCorrectedHeading(double heading_deg);
+
+// Current gyro bias estimate (in degrees per second).
+double getHeadingBias();
+
+// Estimates gyro bias whenever the chassis is still and integrates the corrected heading.
+void headingLoop();
+
+/*
+ * calibrateHeadingScale
+ * Spins the robot in place and measures the inertial scale factor.
+ * Start the robot against a reference (a wall or a tile seam). The robot spins until the
+ * inertial sensor reports the requested number of rotations, then the driver turns it back
+ * onto the reference with the left stick and presses A. The measured scale is applied and
+ * printed so it can be copied into inertial_scale in robot-config.cpp.
+ * - rotations: Number of full rotations to spin.
+ * - voltage: Spin voltage (in volts).
+ */
+double calibrateHeadingScale(int rotations = 5, double voltage = 6);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef __LOCALIZATION__
+#define __LOCALIZATION__
+
+//declarations for Monte Carlo localization against the field walls.
+//Uses field coordinates (inches, origin at the field center, see path-planner.h).
+
+// Number of particles and distance sensors.
+#define LOCALIZATION_PARTICLES 256
+#define MAX_LOCALIZATION_SENSORS 4
+
+// Register a distance sensor that sees the field walls.
+// - offset_x_in: Sensor position right of the tracking center (in inches).
+// - offset_y_in: Sensor position ahead of the tracking center (in inches).
+// - angle_deg: Direction the sensor faces, clockwise from the robot's front (in degrees).
+void addLocalizationSensor(vex::distance& sensor, double offset_x_in, double offset_y_in, double angle_deg);
+
+// Spread the particles around a known pose and move odometry there.
+void resetLocalization(double x, double y, double spread_in = 1);
+
+// Enable or disable publishing the filtered pose to x_pos/y_pos.
+void setLocalizationEnabled(bool enabled);
+
+// Fuses odometry motion with the distance sensors and corrects x_pos/y_pos.
+void localizationLoop();
+
+#endif
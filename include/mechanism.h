@@ -0,0 +1,89 @@
+#ifndef __MECHANISM__
+#define __MECHANISM__
+
+#include "pid.h"
+
+// Maximum number of mechanisms that can be registered with the
+// shared control task.
+#define MAX_MECHANISMS 8
+
+// Position controller for an arm, lift, intake or similar motor. The PID
+// persists between ticks and targets, so derivative and integral terms
+// work and retargeting needs no new thread.
+//
+// Example:
+//   Mechanism arm = Mechanism(arm_motor, 0.1, 0, 0.5);
+//   arm.setGravityFeedforward(0.5, 0);
+//   registerMechanism(arm);   // once, e.g. in runPreAutonomous
+//   arm.setTarget(250);       // from anywhere, takes effect next tick
+class Mechanism {
+ public:
+  Mechanism(vex::motor& new_motor, double new_kp, double new_ki, double new_kd);
+  Mechanism(vex::motor_group& new_motors, double new_kp, double new_ki, double new_kd);
+
+  // Retarget the mechanism (in motor degrees). Takes effect on the
+  // next control tick; no thread needs to be restarted.
+  void setTarget(double new_target);
+  double getTarget();
+
+  // Gravity feedforward for arms: kg * cos(angle), where the angle is
+  // measured from the horizontal_position (motor degrees) and converted
+  // to arm degrees with degrees_per_motor_degree.
+  void setGravityFeedforward(double new_kg, double new_horizontal_position, double new_degrees_per_motor_degree = 1);
+
+  // Static friction feedforward, applied in the direction of the error
+  // while the mechanism is outside its settle tolerance.
+  void setFrictionFeedforward(double new_ks);
+
+  // Trapezoidal motion profile on the setpoint (motor degrees per second
+  // and per second squared). A max_velocity of 0 disables the profile.
+  void setMotionProfile(double new_max_velocity, double new_max_accel);
+
+  void setMaxOutput(double new_max_output);
+  void setTolerance(double new_tolerance);
+
+  // Disabled mechanisms are skipped by the control task so their motor
+  // can be commanded directly.
+  void setEnabled(bool new_enabled);
+  bool isEnabled();
+
+  // Whether the mechanism is within tolerance of its final target.
+  bool targetArrived();
+
+  double getPosition();
+
+  // Run one control step, called by the mechanism control task.
+  void update();
+
+  // Underlying controller, exposed for tuning the exit conditions.
+  PID pid;
+
+ protected:
+  void initialize();
+  void spin(double output);
+
+  vex::motor* motor;
+  vex::motor_group* motors;
+
+  // Final target and the profiled setpoint chasing it.
+  double target, setpoint, setpoint_velocity;
+  bool profile_reset;
+
+  double kg, horizontal_position, degrees_per_motor_degree;
+  double ks;
+  double max_velocity, max_accel;
+  double max_output, tolerance;
+  bool enabled;
+};
+
+// Add a mechanism to the shared control task.
+void registerMechanism(Mechanism& mechanism);
+
+// Registered mechanisms, in registration order.
+int getMechanismCount();
+Mechanism& getMechanism(int index);
+
+// Runs every registered mechanism from a single thread.
+void mechanismControlLoop();
+
+#endif
@@ -1,18 +1,34 @@
 #include <string>
 #include <cmath>
 
+struct Trajectory;
+
 // --- Global Variables (snake_case) ---
 extern bool is_turning;
 
-extern double xpos, ypos;
+extern double x_pos, y_pos;
 extern double correct_angle;
 
+// Result of the last motion primitive, for tuning and diagnostics.
+struct MotionResult {
+  int ticks;           // Control ticks run (10 msec each)
+  double elapsed_msec; // Time the motion took
+  bool timed_out;      // Ended on time_limit_msec instead of settling/crossing
+};
+extern MotionResult last_motion;
+
 // --- Function Declarations (lowerCamelCase) ---
 void driveChassis(double left_power, double right_power);
 
 double getInertialHeading(bool normalize = false);
 double normalizeTarget(double angle);
 
+// Motion markers, staged before a motion primitive and run during it; the primitive discards any left unfired.
+void atDistance(double distance_in, void (*action)());
+void atPercent(double percent, void (*action)());
+void nearTarget(double radius_in, void (*action)());
+void clearMarkers();
+
 void turnToAngle(double turn_angle, double time_limit_msec, bool exit = true, double max_output = 12);
 void driveTo(double distance_in, double time_limit_msec, bool exit = true, double max_output = 12);
 void curveCircle(double result_angle_deg, double center_radius, double time_limit_msec, bool exit = true, double max_output = 12);
@@ -27,6 +43,18 @@ void trackNoOdomWheel();
 void trackXYOdomWheel();
 void trackXOdomWheel();
 void trackYOdomWheel();
+void trackParallelOdomWheel();
+// Sets the heading after a pose reset (setPose, squaring on a wall); the running tracker
+// measures from it and the wheel readings at the reset instead of counting the jump as a turn.
+void resetOdometryHeading(double heading_deg);
 void turnToPoint(double x, double y, int dir, double time_limit_msec);
 void moveToPoint(double x, double y, int dir, double time_limit_msec, bool exit = true, double max_output = 12, bool overturn = false);
-void boomerang(double x, double y, int dir, double a, double dlead, double time_limit_msec, bool exit = true, double max_output = 12, bool overturn = false);
\ No newline at end of file
+void boomerang(double x, double y, int dir, double a, double dlead, double time_limit_msec, bool exit = true, double max_output = 12, bool overturn = false);
+void followTrajectory(Trajectory& trajectory, int dir, double time_limit_msec, bool exit = true, double max_output = 12, double lookahead_in = 8);
+void arcTo(double result_angle_deg, double center_radius, double time_limit_msec, bool exit = true, double max_output = 12);
+void swingTo(double swing_angle, int drive_direction, double time_limit_msec, bool exit = true, double max_output = 12);
+
+// Contact-terminated drives, last_motion.timed_out tells whether the contact was found.
+void driveUntilStalled(double voltage, double time_limit_msec, bool exit = true, bool hold_heading = true);
+void driveUntilDistance(vex::distance& sensor, double distance_in, double voltage, double time_limit_msec, bool exit = true);
+void driveUntilContact(double voltage, double time_limit_msec, bool exit = true, bool hold_heading = true);
\ No newline at end of file
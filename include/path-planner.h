@@ -0,0 +1,34 @@
+#ifndef __PATH_PLANNER__
+#define __PATH_PLANNER__
+
+//declarations for the field occupancy map and the A* path planner.
+//Coordinates are field inches with the origin at the center of the field.
+//Set x_pos/y_pos and the inertial rotation to the starting pose so odometry
+//reports field coordinates.
+
+// Field size and grid resolution (in inches).
+#define FIELD_SIZE_IN 144
+#define FIELD_CELL_IN 2
+#define FIELD_GRID_SIZE (FIELD_SIZE_IN / FIELD_CELL_IN)
+
+// Maximum number of waypoints in a planned path.
+#define MAX_PATH_WAYPOINTS 16
+
+// Add an axis-aligned rectangular obstacle (goal, barrier, ...) to the field map.
+void addFieldObstacle(double x1, double y1, double x2, double y2);
+void clearFieldObstacles();
+
+// Distance kept between the robot center and walls/obstacles (in inches).
+void setPlannerRobotRadius(double radius_in);
+
+// Plans a drivable path from (start_x, start_y) to (goal_x, goal_y).
+// Writes the waypoints (ending with the goal) and returns their count,
+// or 0 if the goal cannot be reached with max_waypoints. Results are cached per start/goal cell.
+int planPath(double start_x, double start_y, double goal_x, double goal_y, double* waypoints_x, double* waypoints_y, int max_waypoints = MAX_PATH_WAYPOINTS);
+
+// Plans from the current pose to (x, y) and follows the path with chained moveToPoint calls.
+// Returns false, leaving the robot where it is, if no path was found; the routine has to
+// pick another target or skip the step.
+bool moveToPointPlanned(double x, double y, int dir, double time_limit_msec, bool exit = true, double max_output = 12);
+
+#endif
@@ -1,29 +1,38 @@
 #ifndef __PID__
 #define __PID__
 
-class PID {
+#include "utils.h"
+
+// PID controller templated on its scalar type. Instantiated for float and
+// double in pid.cpp; use the PID typedef below for the build's control scalar.
+template <typename Scalar>
+class BasicPID {
  public:
-  PID(double new_kp, double new_ki, double new_kd);
+  BasicPID(Scalar new_kp, Scalar new_ki, Scalar new_kd);
   
   // Adjust the kp, ki and kd if needed.
-  void setCoefficient(double new_kp, double new_ki, double new_kd);
+  void setCoefficient(Scalar new_kp, Scalar new_ki, Scalar new_kd);
 
   // Set the desired target value.
-  void setTarget(double new_target);
+  void setTarget(Scalar new_target);
 
   // Set maximum allowed integral.
-  void setIntegralMax(double new_integral_max);
+  void setIntegralMax(Scalar new_integral_max);
 
   // Set the allowed proportional range, ignore the integal
   // value if the proportional is out of this range.
-  void setIntegralRange(double new_integral_range);
+  void setIntegralRange(Scalar new_integral_range);
   
   // Set error and derivative tolerance.
-  void setSmallBigErrorTolerance(double new_small_error_tolerance, double new_big_error_tolerance);
-  void setDerivativeTolerance(double new_derivative_tolerance);
+  void setSmallBigErrorTolerance(Scalar new_small_error_tolerance, Scalar new_big_error_tolerance);
+  void setDerivativeTolerance(Scalar new_derivative_tolerance);
 
   // Reset the sum_error for integral.
   void clearSumError();
+
+  // Forget the error history and arrival state so a long-lived
+  // controller can be retargeted as if it were freshly created.
+  void reset();
   
   // Set the stable time duration as the exit condition check.
   void setSmallBigErrorDuration(double new_small_error_duration, double new_big_error_duration);
@@ -34,28 +43,28 @@ class PID {
   // range.
   bool targetArrived();
   
-  double getI();
+  Scalar getI();
 
   // Calculate the output value.
-  double update(double input);
+  Scalar update(Scalar input);
 
   // Get the calculated output value.
-  double getOutput();
+  Scalar getOutput();
   
   // Util function to design sign (-1, 0, 1) of the number.
-  int sign(double number);
+  int sign(Scalar number);
  
  protected:
   // Desired target value. 
-  double target;
+  Scalar target;
 
   // Exit condition arrived.
   bool arrived, arrive;
 
   // Minimum time duration to hold a stable state so 
   // we can exit the pid loop.
-  double small_error_tolerance;
-  double big_error_tolerance;
+  Scalar small_error_tolerance;
+  Scalar big_error_tolerance;
   double small_error_duration;
   double big_error_duration;
 
@@ -68,27 +77,29 @@ class PID {
   bool first_time;
 
   // PID Coefficient. 
-  double kp, ki, kd;
+  Scalar kp, ki, kd;
 
   // Do not consider integral if the proportional value
   // is out of this range. 
-  double integral_range;
+  Scalar integral_range;
 
   // Max integral value allowed.
-  double integral_max;
+  Scalar integral_max;
 
   // Small tolerance to check both error and derivative.
-  double derivative_tolerance, error_tolerance;
+  Scalar derivative_tolerance, error_tolerance;
   // Temporary value for calculating proportional, 
   // integral, derivative.
-  double current_error, previous_error, sum_error;
+  Scalar current_error, previous_error, sum_error;
 
   // Calculated proportional, integral, derivative.
-  double proportional, integral, derivative;
+  Scalar proportional, integral, derivative;
 
   // Calculated PID output. 
-  double output;
+  Scalar output;
 
 };
 
+typedef BasicPID<control_scalar> PID;
+
 #endif
\ No newline at end of file
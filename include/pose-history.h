@@ -0,0 +1,33 @@
+#ifndef __POSE_HISTORY__
+#define __POSE_HISTORY__
+
+//declarations for the time-indexed pose history used for latency compensation.
+
+// Number of poses kept (one per 10 msec at any odom_substeps, so 128 covers 1.28 s).
+#define POSE_HISTORY_SIZE 128
+
+struct PoseSample {
+  double time_msec; // Brain.timer(msec) when the pose was recorded
+  double x, y;      // (inches)
+  double heading;   // (degrees, unwrapped like getInertialHeading)
+};
+
+// Appends a pose; times must not decrease. Called by the odometry trackers every 10 msec.
+void recordPose(double time_msec, double x, double y, double heading);
+
+// Removes every recorded pose.
+void clearPoseHistory();
+
+// Interpolated pose at time_msec. Returns false (and the nearest recorded pose)
+// when time_msec lies outside the recorded window.
+bool poseAt(double time_msec, PoseSample& pose);
+
+// Pose extrapolated forward to time_msec (e.g. when the next output takes effect)
+// from the velocity over the last velocity_window_msec.
+PoseSample predictPose(double time_msec, double velocity_window_msec = 50);
+
+// Applies a delayed position measurement taken at time_msec: the error against the
+// pose at that time shifts x_pos/y_pos and every pose recorded since.
+bool applyDelayedPosition(double time_msec, double measured_x, double measured_y);
+
+#endif
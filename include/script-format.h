@@ -0,0 +1,81 @@
+#ifndef __SCRIPT_FORMAT__
+#define __SCRIPT_FORMAT__
+
+//declarations for the autonomous bytecode format, shared by the interpreter (auton-script.h)
+//and the host-side compiler in tools/. Free of VEX headers so both can include it.
+//
+//File layout (little-endian):
+//  "VAUT", version, routine count, action count, 0          (1 byte each after the magic)
+//  action names                                               (SCRIPT_NAME_SIZE bytes each, NUL padded)
+//  per routine: name (SCRIPT_NAME_SIZE bytes), instruction count (2 bytes), instructions
+//  instruction: opcode (1 byte), then a 32-bit float for every argument of the opcode
+
+#define SCRIPT_VERSION 1
+#define SCRIPT_NAME_SIZE 16
+#define MAX_SCRIPT_ARGS 9
+
+// Opcodes, in script_opcodes order.
+enum ScriptOpcode {
+  op_set_pose,
+  op_turn_to_angle,
+  op_drive_to,
+  op_curve_circle,
+  op_swing,
+  op_turn_to_point,
+  op_move_to_point,
+  op_boomerang,
+  op_arc_to,
+  op_swing_to,
+  op_drive_until_stalled,
+  op_drive_until_contact,
+  op_square_to_wall,
+  op_wait,
+  op_action,
+  op_set_mechanism,
+  op_wait_mechanism,
+  op_at_distance,
+  op_at_percent,
+  op_near_target,
+  op_after_time,
+  op_when_traveled,
+  op_clear_triggers,
+  SCRIPT_OPCODE_COUNT
+};
+
+// Argument kinds, checked when a routine is loaded:
+// 'n' any number, 't' time (in milliseconds, > 0), 'b' bool (0 or 1), 'd' direction (1 or -1),
+// 'v' voltage (0 to 12), 'w' FieldWall, 'a' action index, 'm' registered mechanism index
+struct ScriptOpcodeInfo {
+  const char* name;                // Name in script source, the C++ function it runs
+  const char* args;                // One kind per argument
+  int required;                    // Arguments without a default
+  float defaults[MAX_SCRIPT_ARGS]; // Values of the optional arguments, as in motor-control.h
+};
+
+static const ScriptOpcodeInfo script_opcodes[SCRIPT_OPCODE_COUNT] = {
+  { "setPose", "nnn", 3, { 0 } },
+  { "turnToAngle", "ntbv", 2, { 0, 0, 1, 12 } },
+  { "driveTo", "ntbv", 2, { 0, 0, 1, 12 } },
+  { "curveCircle", "nntbv", 3, { 0, 0, 0, 1, 12 } },
+  { "swing", "ndtbv", 3, { 0, 0, 0, 1, 12 } },
+  { "turnToPoint", "nndt", 4, { 0 } },
+  { "moveToPoint", "nndtbvb", 4, { 0, 0, 0, 0, 1, 12, 0 } },
+  { "boomerang", "nndnntbvb", 6, { 0, 0, 0, 0, 0, 0, 1, 12, 0 } },
+  { "arcTo", "nntbv", 3, { 0, 0, 0, 1, 12 } },
+  { "swingTo", "ndtbv", 3, { 0, 0, 0, 1, 12 } },
+  { "driveUntilStalled", "ntbb", 2, { 0, 0, 1, 1 } },
+  { "driveUntilContact", "ntbb", 2, { 0, 0, 1, 1 } },
+  { "squareToWall", "wdt", 3, { 0 } },
+  { "wait", "t", 1, { 0 } },
+  { "action", "a", 1, { 0 } },
+  { "setMechanism", "mn", 2, { 0 } },
+  { "waitMechanism", "mt", 2, { 0 } },
+  { "atDistance", "na", 2, { 0 } },
+  { "atPercent", "na", 2, { 0 } },
+  { "nearTarget", "na", 2, { 0 } },
+  { "afterTime", "ta", 2, { 0 } },
+  { "whenTraveled", "na", 2, { 0 } },
+  { "clearTriggers", "", 0, { 0 } },
+};
+
+#endif
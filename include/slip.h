@@ -0,0 +1,29 @@
+#ifndef __SLIP__
+#define __SLIP__
+
+//declarations for wheel-slip detection and traction control.
+
+/*
+ * slipForward
+ * Compares drive encoder travel against the tracking wheels (or, without a forward tracking
+ * wheel, against the velocity integrated from the inertial sensor) over 10 msec windows and
+ * returns the forward travel of this step odometry should trust. Called by the odometry
+ * trackers every step; sub-steps are summed into the window, so the slip decision does not
+ * depend on odom_substeps.
+ * - encoder_forward_in: Forward travel of the tracking center from the drive encoders (in inches).
+ * - tracker_forward_in: Forward travel from the tracking wheels (in inches).
+ * - has_tracker: True when tracker_forward_in is measured.
+ * - dt_sec: Length of the step (in seconds).
+ */
+double slipForward(double encoder_forward_in, double tracker_forward_in, bool has_tracker, double dt_sec);
+
+// True while the drive wheels are slipping.
+bool isSlipping();
+
+// Drive encoder travel not matched by the robot's motion (in inches, only ever grows).
+double getSlipDistance();
+
+// Output fraction the traction control allows (traction_slip_scale while slipping, back to 1 after).
+double getTractionScale();
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __TRAJECTORY__
+#define __TRAJECTORY__
+
+//declarations for time-optimal velocity planning along a geometric path.
+
+// Maximum number of samples in a trajectory (at the default 1 inch spacing).
+#define MAX_TRAJECTORY_POINTS 300
+
+// A path sampled at even spacing with the fastest feasible velocity at every sample.
+struct Trajectory {
+  int count;
+  double x[MAX_TRAJECTORY_POINTS], y[MAX_TRAJECTORY_POINTS];
+  double distance[MAX_TRAJECTORY_POINTS];  // along the path from the start (inches)
+  double curvature[MAX_TRAJECTORY_POINTS]; // signed, positive curves right (1/inches)
+  double velocity[MAX_TRAJECTORY_POINTS];  // (inches per second)
+  double time[MAX_TRAJECTORY_POINTS];      // from the start (seconds)
+};
+
+// Samples the polyline through the waypoints every spacing_in inches and computes
+// the velocity profile: each sample is limited by wheel speed (max_velocity on
+// the outer wheel), lateral acceleration (max_lateral_accel) and curvature, then a
+// forward pass limits acceleration and a backward pass limits deceleration (max_accel).
+// The profile starts at start_velocity and ends at end_velocity.
+// Returns the total time of the trajectory in seconds, or -1 if the path needs more than
+// MAX_TRAJECTORY_POINTS samples at spacing_in. The trajectory is then left empty, so
+// followTrajectory does not move; plan with a wider spacing or split the path.
+double generateTrajectory(Trajectory& trajectory, const double* waypoints_x, const double* waypoints_y, int waypoint_count,
+                          double max_velocity, double max_accel, double max_lateral_accel,
+                          double start_velocity = 0, double end_velocity = 0, double spacing_in = 1);
+
+#endif
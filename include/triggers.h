@@ -0,0 +1,38 @@
+#ifndef __TRIGGERS__
+#define __TRIGGERS__
+
+// Maximum number of triggers that can be active at the same time.
+#define MAX_TRIGGERS 16
+
+// How a trigger behaves after its condition is met.
+// - trigger_once:    run the action once, then free the trigger.
+// - trigger_latched: run the action once and stay registered so
+//                    triggerFired() reports it until cancelled.
+// - trigger_repeat:  run the action on every false -> true transition.
+enum TriggerMode { trigger_once, trigger_latched, trigger_repeat };
+
+// Register a condition -> action pair evaluated every tick by triggerLoop.
+// Conditions and actions are plain functions (captureless lambdas work).
+// debounce_msec: how long the condition must hold before the action runs.
+// Returns the trigger id, or -1 if all trigger slots are in use.
+int addTrigger(bool (*condition)(), void (*action)(), TriggerMode mode = trigger_once, double debounce_msec = 0);
+
+// Built-in conditions.
+int whenDistanceBelow(vex::distance& sensor, double distance_mm, void (*action)(), TriggerMode mode = trigger_once, double debounce_msec = 0);
+int whenHueInRange(vex::optical& sensor, double min_hue, double max_hue, void (*action)(), TriggerMode mode = trigger_once, double debounce_msec = 0);
+int whenObjectNear(vex::optical& sensor, void (*action)(), TriggerMode mode = trigger_once, double debounce_msec = 0);
+int whenTraveled(double distance_in, void (*action)(), TriggerMode mode = trigger_once);
+int afterTime(double time_msec, void (*action)());
+
+// Remove a trigger before it fires. Ids of finished triggers are ignored.
+void cancelTrigger(int id);
+void cancelAllTriggers();
+
+// Whether the trigger has run its action at least once. Stays true for
+// trigger_once triggers after they are freed.
+bool triggerFired(int id);
+
+// Evaluates every active trigger from a single thread.
+void triggerLoop();
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef __TUNING__
+#define __TUNING__
+
+#include <cstdio>
+
+//declarations for the live tuning console.
+//Sets registered tunables (see config-store.h) over USB serial or from the controller
+//and reruns a test motion, reporting how it settled.
+
+// Test motions the console can run.
+enum TuningTest { tuning_turn, tuning_drive };
+
+// How a test motion settled. Distances are degrees for a turn and inches for a drive.
+struct TuningResult {
+  double settle_msec; // Time until the motion ended (last_motion.elapsed_msec)
+  double rise_msec;   // Time until the target was first reached, -1 if never
+  double overshoot;   // Furthest travel past the target
+  double final_error; // Target minus the travel where the motion ended
+  bool timed_out;     // Ended on the time limit instead of settling
+};
+
+/*
+ * runTuningTest
+ * Turns by amount degrees (from the current heading) or drives amount inches with turnToAngle/driveTo,
+ * sampling the travel every 10 msec to measure the overshoot.
+ * - test: Motion to run.
+ * - amount: Size of the motion, negative to turn left or drive backwards.
+ * - time_limit_msec: Maximum time allowed for the motion (in milliseconds).
+ */
+TuningResult runTuningTest(TuningTest test, double amount, double time_limit_msec = 3000);
+
+/*
+ * tuningCommand
+ * Runs one line of the serial protocol and writes the reply to out. Every command ends with
+ * a line starting "ok" or "error".
+ *   list                   name value min max, one line per tunable
+ *   get <name>             current value
+ *   set <name> <value>     validated like config.ini values
+ *   turn [deg] / drive [in]  runs the test motion (default tuning_turn_deg/tuning_drive_in)
+ *   save / load [profile]  writes or rereads CONFIG_FILE
+ * Returns false if the command was not understood.
+ */
+bool tuningCommand(const char* line, FILE* out);
+
+// Reads commands from USB serial and runs the controller tuning screen.
+// Started from runPreAutonomous when tuning_console is set.
+void tuningLoop();
+
+#endif
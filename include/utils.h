@@ -9,10 +9,19 @@
 #include <climits>
 #include <algorithm>
 
+// Scalar type used by the control stack (PID, odometry deltas, output scaling).
+// Build with CONTROL_FLOAT = 1 in the makefile for single precision.
+#ifdef CONTROL_FLOAT
+typedef float control_scalar;
+#else
+typedef double control_scalar;
+#endif
+
 double degToRad(double deg);
 
 double radToDeg(double rad);
 
-double getRadius(double x, double y, double x1, double y1, double angle);
+template <typename Scalar>
+Scalar getRadius(Scalar x, Scalar y, Scalar x1, Scalar y1, Scalar angle);
 
 #endif
@@ -0,0 +1,25 @@
+#ifndef __WALL_RESET__
+#define __WALL_RESET__
+
+//declarations for re-zeroing the pose against the field walls.
+//Uses field coordinates (inches, origin at the field center, see path-planner.h).
+
+// Field walls; top is the +y wall, right the +x wall.
+enum FieldWall { wall_top, wall_right, wall_bottom, wall_left };
+
+/*
+ * squareToWall
+ * Drives into a field wall until the drive stalls, keeps pushing until both sides are flat
+ * against it, then snaps the heading and the coordinate across the wall to the field geometry.
+ * With a distance sensor facing another wall the other coordinate is measured as well.
+ * - wall: Wall to square against.
+ * - drive_direction: 1 to drive into it front first, -1 back first.
+ * - time_limit_msec: Maximum time allowed to reach the wall (in milliseconds).
+ * - sensor: Optional distance sensor facing a wall perpendicular to this one.
+ * - sensor_angle_deg: Direction the sensor faces, clockwise from the robot's front (in degrees).
+ * - sensor_offset_in: Distance from the tracking center to the sensor along its beam (in inches).
+ * Returns false (and changes nothing) if the wall was not reached.
+ */
+bool squareToWall(FieldWall wall, int drive_direction, double time_limit_msec, vex::distance* sensor = 0, double sensor_angle_deg = 0, double sensor_offset_in = 0);
+
+#endif
@@ -0,0 +1,281 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "mechanism.h"
+#include "triggers.h"
+#include "wall-reset.h"
+#include "pose-history.h"
+#include "localization.h"
+#include "auton-script.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// One decoded instruction; unused arguments are 0
+struct ScriptInstruction {
+  unsigned char opcode;
+  float args[MAX_SCRIPT_ARGS];
+};
+
+struct ScriptRoutine {
+  char name[SCRIPT_NAME_SIZE + 1];
+  int first, count; // Range in script_instructions
+};
+
+struct ScriptAction {
+  const char* name;
+  void (*action)();
+};
+
+ScriptAction script_actions[MAX_SCRIPT_ACTIONS];
+int script_action_count = 0;
+
+ScriptInstruction script_instructions[MAX_SCRIPT_INSTRUCTIONS];
+ScriptRoutine script_routines[MAX_SCRIPT_ROUTINES];
+int script_routine_count = 0;
+
+// File action index -> script_actions index, resolved by loadScripts
+int action_map[MAX_SCRIPT_ACTIONS];
+
+// Largest routine file (in bytes)
+#define MAX_SCRIPT_FILE 16384
+unsigned char script_buffer[MAX_SCRIPT_FILE];
+char script_error[64] = "";
+
+bool addScriptAction(const char* name, void (*action)()) {
+  if (script_action_count >= MAX_SCRIPT_ACTIONS) {
+    return false;
+  }
+  script_actions[script_action_count].name = name;
+  script_actions[script_action_count].action = action;
+  script_action_count++;
+  return true;
+}
+
+// ============================================================================
+// LOADING AND VALIDATION
+// ============================================================================
+
+/*
+ * Reads a little-endian 32-bit float.
+ */
+float readScriptFloat(const unsigned char* bytes) {
+  uint32_t bits = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/*
+ * Whether an argument value is allowed for its kind (see script-format.h).
+ */
+bool validScriptArg(char kind, float value, int action_count) {
+  if (!std::isfinite(value)) {
+    return false;
+  }
+  switch (kind) {
+  case 't': return value > 0;
+  case 'b': return value == 0 || value == 1;
+  case 'd': return value == 1 || value == -1;
+  case 'v': return value >= 0 && value <= 12;
+  case 'w': return value == wall_top || value == wall_right || value == wall_bottom || value == wall_left;
+  case 'a': return value == floor(value) && value >= 0 && value < action_count;
+  case 'm': return value == floor(value) && value >= 0 && value < getMechanismCount();
+  default: return true;
+  }
+}
+
+bool loadScripts(const char* file) {
+  script_routine_count = 0;
+  if (!Brain.SDcard.isInserted()) {
+    snprintf(script_error, sizeof(script_error), "no SD card");
+    return false;
+  }
+  int length = Brain.SDcard.loadfile(file, script_buffer, MAX_SCRIPT_FILE);
+  if (length <= 0) {
+    snprintf(script_error, sizeof(script_error), "no %s", file);
+    return false;
+  }
+  if (length < 8 || memcmp(script_buffer, "VAUT", 4) != 0 || script_buffer[4] != SCRIPT_VERSION) {
+    snprintf(script_error, sizeof(script_error), "not a version %d routine file", SCRIPT_VERSION);
+    return false;
+  }
+  int routine_count = script_buffer[5], action_count = script_buffer[6];
+  if (routine_count > MAX_SCRIPT_ROUTINES || action_count > MAX_SCRIPT_ACTIONS) {
+    snprintf(script_error, sizeof(script_error), "too many routines or actions");
+    return false;
+  }
+  int position = 8;
+
+  // Actions are stored by name so the robot's registration order does not matter
+  for (int i = 0; i < action_count; i++) {
+    if (position + SCRIPT_NAME_SIZE > length) {
+      snprintf(script_error, sizeof(script_error), "file truncated");
+      return false;
+    }
+    char name[SCRIPT_NAME_SIZE + 1] = "";
+    memcpy(name, script_buffer + position, SCRIPT_NAME_SIZE);
+    position += SCRIPT_NAME_SIZE;
+    action_map[i] = -1;
+    for (int j = 0; j < script_action_count; j++) {
+      if (strcmp(script_actions[j].name, name) == 0) {
+        action_map[i] = j;
+      }
+    }
+    if (action_map[i] < 0) {
+      snprintf(script_error, sizeof(script_error), "action %s not registered", name);
+      return false;
+    }
+  }
+
+  int instruction_count = 0;
+  for (int r = 0; r < routine_count; r++) {
+    if (position + SCRIPT_NAME_SIZE + 2 > length) {
+      snprintf(script_error, sizeof(script_error), "file truncated");
+      return false;
+    }
+    ScriptRoutine& routine = script_routines[r];
+    memset(routine.name, 0, sizeof(routine.name));
+    memcpy(routine.name, script_buffer + position, SCRIPT_NAME_SIZE);
+    routine.count = script_buffer[position + SCRIPT_NAME_SIZE] | (script_buffer[position + SCRIPT_NAME_SIZE + 1] << 8);
+    routine.first = instruction_count;
+    position += SCRIPT_NAME_SIZE + 2;
+    if (instruction_count + routine.count > MAX_SCRIPT_INSTRUCTIONS) {
+      snprintf(script_error, sizeof(script_error), "more than %d instructions", MAX_SCRIPT_INSTRUCTIONS);
+      return false;
+    }
+
+    for (int i = 0; i < routine.count; i++) {
+      ScriptInstruction& instruction = script_instructions[instruction_count++];
+      memset(&instruction, 0, sizeof(instruction));
+      if (position >= length || script_buffer[position] >= SCRIPT_OPCODE_COUNT) {
+        snprintf(script_error, sizeof(script_error), "%.16s step %d: bad opcode", routine.name, i + 1);
+        return false;
+      }
+      instruction.opcode = script_buffer[position++];
+      const char* kinds = script_opcodes[instruction.opcode].args;
+      int arg_count = strlen(kinds);
+      if (position + arg_count * 4 > length) {
+        snprintf(script_error, sizeof(script_error), "file truncated");
+        return false;
+      }
+      for (int a = 0; a < arg_count; a++) {
+        instruction.args[a] = readScriptFloat(script_buffer + position);
+        position += 4;
+        if (!validScriptArg(kinds[a], instruction.args[a], action_count)) {
+          snprintf(script_error, sizeof(script_error), "%.16s step %d: bad argument %d", routine.name, i + 1, a + 1);
+          return false;
+        }
+        if (kinds[a] == 'a') {
+          instruction.args[a] = action_map[(int)instruction.args[a]];
+        }
+      }
+    }
+  }
+  if (position != length) {
+    snprintf(script_error, sizeof(script_error), "trailing data");
+    return false;
+  }
+
+  script_routine_count = routine_count;
+  script_error[0] = 0;
+  return true;
+}
+
+const char* getScriptError() {
+  return script_error;
+}
+
+int getScriptCount() {
+  return script_routine_count;
+}
+
+const char* getScriptName(int index) {
+  return script_routines[index].name;
+}
+
+int findScript(const char* name) {
+  for (int i = 0; i < script_routine_count; i++) {
+    if (strcmp(script_routines[i].name, name) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// ============================================================================
+// INTERPRETER
+// ============================================================================
+
+/*
+ * Runs one validated instruction. Everything was checked by loadScripts, so this is a
+ * single switch: a few nanoseconds against the 10 msec control tick of the primitive it calls.
+ */
+void executeInstruction(const ScriptInstruction& instruction) {
+  const float* a = instruction.args;
+  switch (instruction.opcode) {
+  case op_set_pose:
+    resetOdometryHeading(a[2]);
+    clearPoseHistory();
+    resetLocalization(a[0], a[1]);
+    break;
+  case op_turn_to_angle: turnToAngle(a[0], a[1], a[2] != 0, a[3]); break;
+  case op_drive_to: driveTo(a[0], a[1], a[2] != 0, a[3]); break;
+  case op_curve_circle: curveCircle(a[0], a[1], a[2], a[3] != 0, a[4]); break;
+  case op_swing: swing(a[0], a[1], a[2], a[3] != 0, a[4]); break;
+  case op_turn_to_point: turnToPoint(a[0], a[1], (int)a[2], a[3]); break;
+  case op_move_to_point: moveToPoint(a[0], a[1], (int)a[2], a[3], a[4] != 0, a[5], a[6] != 0); break;
+  case op_boomerang: boomerang(a[0], a[1], (int)a[2], a[3], a[4], a[5], a[6] != 0, a[7], a[8] != 0); break;
+  case op_arc_to: arcTo(a[0], a[1], a[2], a[3] != 0, a[4]); break;
+  case op_swing_to: swingTo(a[0], (int)a[1], a[2], a[3] != 0, a[4]); break;
+  case op_drive_until_stalled: driveUntilStalled(a[0], a[1], a[2] != 0, a[3] != 0); break;
+  case op_drive_until_contact: driveUntilContact(a[0], a[1], a[2] != 0, a[3] != 0); break;
+  case op_square_to_wall: squareToWall((FieldWall)(int)a[0], (int)a[1], a[2]); break;
+  case op_wait: wait(a[0], msec); break;
+  case op_action: script_actions[(int)a[0]].action(); break;
+  case op_set_mechanism: getMechanism((int)a[0]).setTarget(a[1]); break;
+  case op_wait_mechanism: {
+    double start_time = Brain.timer(msec);
+    while (!getMechanism((int)a[0]).targetArrived() && Brain.timer(msec) - start_time < a[1]) {
+      wait(10, msec);
+    }
+    break;
+  }
+  case op_at_distance: atDistance(a[0], script_actions[(int)a[1]].action); break;
+  case op_at_percent: atPercent(a[0], script_actions[(int)a[1]].action); break;
+  case op_near_target: nearTarget(a[0], script_actions[(int)a[1]].action); break;
+  case op_after_time: afterTime(a[0], script_actions[(int)a[1]].action); break;
+  case op_when_traveled: whenTraveled(a[0], script_actions[(int)a[1]].action); break;
+  case op_clear_triggers:
+    clearMarkers();
+    cancelAllTriggers();
+    break;
+  }
+}
+
+bool runScript(int index) {
+  if (index < 0 || index >= script_routine_count) {
+    return false;
+  }
+  const ScriptRoutine& routine = script_routines[index];
+  for (int i = routine.first; i < routine.first + routine.count; i++) {
+    executeInstruction(script_instructions[i]);
+  }
+  return true;
+}
+
+int getScriptLength(int index) {
+  return index >= 0 && index < script_routine_count ? script_routines[index].count : 0;
+}
+
+bool runScriptStep(int index, int step) {
+  if (step < 0 || step >= getScriptLength(index)) {
+    return false;
+  }
+  executeInstruction(script_instructions[script_routines[index].first + step]);
+  return true;
+}
@@ -0,0 +1,45 @@
+#include "vex.h"
+#include "battery.h"
+#include "../custom/include/robot-config.h"
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+double filtered_battery_voltage = 0;
+double battery_sample_time = 0;
+
+// Below this the reading is not a real battery (brain on USB power, in volts)
+const double min_battery_voltage = 6;
+
+double getBatteryVoltage() {
+  double now = Brain.timer(msec);
+  double voltage = Brain.Battery.voltage(volt);
+  if (filtered_battery_voltage <= 0) {
+    filtered_battery_voltage = voltage;
+  } else {
+    // First-order filter, the gain follows the time since the last sample
+    double dt = (now - battery_sample_time) / 1000.0;
+    double gain = dt / (battery_filter_sec + dt);
+    filtered_battery_voltage += gain * (voltage - filtered_battery_voltage);
+  }
+  battery_sample_time = now;
+  return filtered_battery_voltage;
+}
+
+double getBatteryScale() {
+  if (!battery_compensation) {
+    return 1;
+  }
+  double battery = getBatteryVoltage();
+  if (battery < min_battery_voltage) {
+    return 1;
+  }
+  return battery_reference_voltage / battery;
+}
+
+double compensateVoltage(double volts) {
+  double output = volts * getBatteryScale();
+  if (output > 12) output = 12;
+  else if (output < -12) output = -12;
+  return output;
+}
@@ -0,0 +1,221 @@
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "calibration.h"
+#include "config-store.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+#include <cstring>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// Sensor slots in GeometryFit
+enum { sensor_left, sensor_right, sensor_vertical, sensor_horizontal, sensor_right_vertical, sensor_count };
+
+// Tunables saved to GEOMETRY_FILE
+const char* const geometry_names[] = {
+  "wheel_distance_in",
+  "distance_between_wheels",
+  "vertical_tracker_diameter",
+  "right_vertical_tracker_diameter",
+  "vertical_tracker_dist_from_center",
+  "horizontal_tracker_dist_from_center",
+  "right_vertical_tracker_dist_from_center",
+};
+const int geometry_name_count = sizeof(geometry_names) / sizeof(geometry_names[0]);
+
+// Drive voltage between the walls and while spinning
+const double calibration_voltage = 6;
+
+// ============================================================================
+// LEAST-SQUARES FIT
+// ============================================================================
+
+void clearGeometryFit(GeometryFit& fit) {
+  memset(&fit, 0, sizeof(fit));
+}
+
+/*
+ * Sensor travel of a step by slot.
+ */
+double stepTravel(const CalibrationStep& step, int sensor) {
+  switch (sensor) {
+  case sensor_left: return step.left_deg;
+  case sensor_right: return step.right_deg;
+  case sensor_vertical: return step.vertical_deg;
+  case sensor_horizontal: return step.horizontal_deg;
+  default: return step.right_vertical_deg;
+  }
+}
+
+void addStraightRun(GeometryFit& fit, double travel_in, const CalibrationStep& run) {
+  for (int i = 0; i < sensor_count; i++) {
+    double travel_deg = stepTravel(run, i);
+    fit.straight_dd[i] += travel_deg * travel_deg;
+    fit.straight_td[i] += travel_in * travel_deg;
+  }
+  fit.straight_runs++;
+}
+
+void addSpinStep(GeometryFit& fit, const CalibrationStep& step) {
+  fit.spin_hh += step.delta_heading_rad * step.delta_heading_rad;
+  for (int i = 0; i < sensor_count; i++) {
+    fit.spin_hd[i] += step.delta_heading_rad * stepTravel(step, i);
+  }
+  fit.spin_steps++;
+}
+
+bool solveGeometry(const GeometryFit& fit, GeometryCalibration& geometry) {
+  if (fit.spin_hh <= 0) {
+    return false;
+  }
+  bool has_vertical = using_vertical_tracker || using_parallel_trackers;
+
+  // Inches per degree of each wheel, from the straight runs where there are any
+  double drive_dd = fit.straight_dd[sensor_left] + fit.straight_dd[sensor_right];
+  if (drive_dd > 0) {
+    geometry.wheel_distance_in = (fit.straight_td[sensor_left] + fit.straight_td[sensor_right]) / drive_dd * 360;
+  }
+  if (has_vertical && fit.straight_dd[sensor_vertical] > 0) {
+    geometry.vertical_tracker_diameter = fit.straight_td[sensor_vertical] / fit.straight_dd[sensor_vertical] * 360 / M_PI;
+  }
+  if (using_parallel_trackers && fit.straight_dd[sensor_right_vertical] > 0) {
+    geometry.right_vertical_tracker_diameter = fit.straight_td[sensor_right_vertical] / fit.straight_dd[sensor_right_vertical] * 360 / M_PI;
+  }
+
+  // Degrees each wheel turns per radian of spin. Spinning clockwise the left side moves forward
+  // by half the drive width per radian, and a wheel offset to the right (or behind) moves back.
+  double drive_scale = geometry.wheel_distance_in / 360;
+  geometry.distance_between_wheels = (fit.spin_hd[sensor_left] - fit.spin_hd[sensor_right]) / fit.spin_hh * drive_scale;
+  if (has_vertical) {
+    geometry.vertical_tracker_dist_from_center = -fit.spin_hd[sensor_vertical] / fit.spin_hh * geometry.vertical_tracker_diameter * M_PI / 360;
+  }
+  if (using_horizontal_tracker) {
+    geometry.horizontal_tracker_dist_from_center = -fit.spin_hd[sensor_horizontal] / fit.spin_hh * horizontal_tracker_diameter * M_PI / 360;
+  }
+  if (using_parallel_trackers) {
+    geometry.right_vertical_tracker_dist_from_center = -fit.spin_hd[sensor_right_vertical] / fit.spin_hh * geometry.right_vertical_tracker_diameter * M_PI / 360;
+  }
+  return true;
+}
+
+// ============================================================================
+// GEOMETRY GLOBALS AND SD CARD
+// ============================================================================
+
+GeometryCalibration currentGeometry() {
+  GeometryCalibration geometry = { wheel_distance_in, distance_between_wheels,
+                                   vertical_tracker_diameter, right_vertical_tracker_diameter,
+                                   vertical_tracker_dist_from_center, horizontal_tracker_dist_from_center, right_vertical_tracker_dist_from_center };
+  return geometry;
+}
+
+void applyGeometry(const GeometryCalibration& geometry) {
+  wheel_distance_in = geometry.wheel_distance_in;
+  distance_between_wheels = geometry.distance_between_wheels;
+  vertical_tracker_diameter = geometry.vertical_tracker_diameter;
+  right_vertical_tracker_diameter = geometry.right_vertical_tracker_diameter;
+  vertical_tracker_dist_from_center = geometry.vertical_tracker_dist_from_center;
+  horizontal_tracker_dist_from_center = geometry.horizontal_tracker_dist_from_center;
+  right_vertical_tracker_dist_from_center = geometry.right_vertical_tracker_dist_from_center;
+}
+
+bool saveGeometry() {
+  return saveConfig(GEOMETRY_FILE, geometry_names, geometry_name_count);
+}
+
+bool loadGeometry() {
+  return loadConfig(GEOMETRY_FILE);
+}
+
+// ============================================================================
+// GUIDED CALIBRATION
+// ============================================================================
+
+/*
+ * Absolute readings of every sensor, differenced into steps by stepBetween.
+ */
+CalibrationStep readSensors() {
+  CalibrationStep reading = { degToRad(getInertialHeading()), getLeftRotationDegree(), getRightRotationDegree(),
+                              vertical_tracker.position(degrees), horizontal_tracker.position(degrees), right_vertical_tracker.position(degrees) };
+  return reading;
+}
+
+CalibrationStep stepBetween(const CalibrationStep& start, const CalibrationStep& end) {
+  CalibrationStep step = { end.delta_heading_rad - start.delta_heading_rad, end.left_deg - start.left_deg, end.right_deg - start.right_deg,
+                           end.vertical_deg - start.vertical_deg, end.horizontal_deg - start.horizontal_deg, end.right_vertical_deg - start.right_vertical_deg };
+  return step;
+}
+
+/*
+ * Drives to the wall ahead (or behind), adds the run to the fit and squares against the wall.
+ * Returns false if the wall was not reached.
+ */
+bool calibrationRun(GeometryFit& fit, int drive_direction, double travel_in) {
+  CalibrationStep start = readSensors();
+  driveUntilStalled(calibration_voltage * drive_direction, 10000, false, true);
+  if (last_motion.timed_out) {
+    stopChassis(vex::hold);
+    return false;
+  }
+  // Read at contact, before pushing into the wall makes the drive wheels slip
+  addStraightRun(fit, travel_in * drive_direction, stepBetween(start, readSensors()));
+  driveChassis(square_voltage * drive_direction, square_voltage * drive_direction);
+  wait(300, msec);
+  stopChassis(vex::hold);
+  wait(200, msec);
+  return true;
+}
+
+/*
+ * Spins in place, adding every 10 msec step to the fit.
+ */
+void calibrationSpin(GeometryFit& fit, int turn_direction, int rotations) {
+  CalibrationStep start = readSensors(), previous = start;
+  while (fabs(previous.delta_heading_rad - start.delta_heading_rad) < rotations * 2 * M_PI) {
+    driveChassis(calibration_voltage * turn_direction, -calibration_voltage * turn_direction);
+    wait(10, msec);
+    CalibrationStep current = readSensors();
+    addSpinStep(fit, stepBetween(previous, current));
+    previous = current;
+  }
+  stopChassis(vex::hold);
+  wait(300, msec);
+}
+
+bool calibrateGeometry(double wall_gap_in, int straight_runs, int rotations) {
+  GeometryFit fit;
+  clearGeometryFit(fit);
+  double travel_in = wall_gap_in - front_bumper_in - back_bumper_in;
+
+  for (int i = 0; i < straight_runs; i++) {
+    if (!calibrationRun(fit, 1, travel_in) || !calibrationRun(fit, -1, travel_in)) {
+      Brain.Screen.clearScreen();
+      Brain.Screen.setCursor(1, 1);
+      Brain.Screen.print("Calibration: wall not reached");
+      return false;
+    }
+  }
+  // Spin both ways so gyro bias cancels
+  calibrationSpin(fit, 1, rotations);
+  calibrationSpin(fit, -1, rotations);
+
+  GeometryCalibration geometry = currentGeometry();
+  if (!solveGeometry(fit, geometry)) {
+    return false;
+  }
+  applyGeometry(geometry);
+  bool saved = saveGeometry();
+
+  Brain.Screen.clearScreen();
+  Brain.Screen.setCursor(1, 1);
+  for (int i = 0; i < geometry_name_count; i++) {
+    Brain.Screen.print("%s = %.4f", geometry_names[i], getConfigValue(*findConfig(geometry_names[i])));
+    Brain.Screen.newLine();
+  }
+  Brain.Screen.print(saved ? "Saved to " GEOMETRY_FILE : "No SD card, not saved");
+  return true;
+}
@@ -0,0 +1,269 @@
+#include "vex.h"
+#include "config-store.h"
+#include "auton-script.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// Every tunable the store can set, with the range a value must fall in
+ConfigEntry config_entries[] = {
+  { "distance_between_wheels", config_double, &distance_between_wheels, 4, 30 },
+  { "wheel_distance_in", config_double, &wheel_distance_in, 1, 30 },
+  { "distance_kp", config_double, &distance_kp, 0, 100 },
+  { "distance_ki", config_double, &distance_ki, 0, 100 },
+  { "distance_kd", config_double, &distance_kd, 0, 100 },
+  { "turn_kp", config_double, &turn_kp, 0, 100 },
+  { "turn_ki", config_double, &turn_ki, 0, 100 },
+  { "turn_kd", config_double, &turn_kd, 0, 100 },
+  { "heading_correction_kp", config_double, &heading_correction_kp, 0, 100 },
+  { "heading_correction_ki", config_double, &heading_correction_ki, 0, 100 },
+  { "heading_correction_kd", config_double, &heading_correction_kd, 0, 100 },
+  { "using_horizontal_tracker", config_bool, &using_horizontal_tracker, 0, 1 },
+  { "using_vertical_tracker", config_bool, &using_vertical_tracker, 0, 1 },
+  { "using_parallel_trackers", config_bool, &using_parallel_trackers, 0, 1 },
+  { "horizontal_tracker_dist_from_center", config_double, &horizontal_tracker_dist_from_center, -15, 15 },
+  { "vertical_tracker_dist_from_center", config_double, &vertical_tracker_dist_from_center, -15, 15 },
+  { "horizontal_tracker_diameter", config_double, &horizontal_tracker_diameter, 0.5, 5 },
+  { "vertical_tracker_diameter", config_double, &vertical_tracker_diameter, 0.5, 5 },
+  { "right_vertical_tracker_dist_from_center", config_double, &right_vertical_tracker_dist_from_center, -15, 15 },
+  { "right_vertical_tracker_diameter", config_double, &right_vertical_tracker_diameter, 0.5, 5 },
+  { "tracker_heading_weight", config_double, &tracker_heading_weight, 0, 1 },
+  { "odom_substeps", config_int, &odom_substeps, 1, 10 },
+  { "heading_correction", config_bool, &heading_correction, 0, 1 },
+  { "drive_line_following", config_bool, &drive_line_following, 0, 1 },
+  { "line_lookahead_in", config_double, &line_lookahead_in, 1, 48 },
+  { "dir_change_start", config_bool, &dir_change_start, 0, 1 },
+  { "dir_change_end", config_bool, &dir_change_end, 0, 1 },
+  { "min_output", config_double, &min_output, 0, 12 },
+  { "max_slew_accel_fwd", config_double, &max_slew_accel_fwd, 0.1, 24 },
+  { "max_slew_decel_fwd", config_double, &max_slew_decel_fwd, 0.1, 24 },
+  { "max_slew_accel_rev", config_double, &max_slew_accel_rev, 0.1, 24 },
+  { "max_slew_decel_rev", config_double, &max_slew_decel_rev, 0.1, 24 },
+  { "chase_power", config_double, &chase_power, 0, 20 },
+  { "max_chassis_velocity", config_double, &max_chassis_velocity, 1, 200 },
+  { "max_chassis_accel", config_double, &max_chassis_accel, 1, 1000 },
+  { "max_lateral_accel", config_double, &max_lateral_accel, 1, 1000 },
+  { "inertial_scale", config_double, &inertial_scale, 0.9, 1.1 },
+  { "battery_compensation", config_bool, &battery_compensation, 0, 1 },
+  { "battery_reference_voltage", config_double, &battery_reference_voltage, 10, 15 },
+  { "battery_filter_sec", config_double, &battery_filter_sec, 0, 10 },
+  { "thermal_governor", config_bool, &thermal_governor, 0, 1 },
+  { "governor_derate_temp", config_double, &governor_derate_temp, 30, 70 },
+  { "governor_start_headroom", config_double, &governor_start_headroom, 0, 40 },
+  { "governor_min_scale", config_double, &governor_min_scale, 0, 1 },
+  { "governor_report", config_bool, &governor_report, 0, 1 },
+  { "slip_detection", config_bool, &slip_detection, 0, 1 },
+  { "slip_velocity_threshold", config_double, &slip_velocity_threshold, 0, 100 },
+  { "traction_slip_scale", config_double, &traction_slip_scale, 0, 1 },
+  { "stall_velocity_rpm", config_double, &stall_velocity_rpm, 0, 600 },
+  { "stall_current_amp", config_double, &stall_current_amp, 0, 2.5 },
+  { "stall_grace_msec", config_double, &stall_grace_msec, 0, 2000 },
+  { "contact_jerk", config_double, &contact_jerk, 0, 1000 },
+  { "front_bumper_in", config_double, &front_bumper_in, 0, 20 },
+  { "back_bumper_in", config_double, &back_bumper_in, 0, 20 },
+  { "square_voltage", config_double, &square_voltage, 0, 12 },
+  { "tuning_console", config_bool, &tuning_console, 0, 1 },
+  { "tuning_turn_deg", config_double, &tuning_turn_deg, -180, 180 },
+  { "tuning_drive_in", config_double, &tuning_drive_in, -72, 72 },
+  { "auton_script", config_int, &auton_script, -1, MAX_SCRIPT_ROUTINES - 1 },
+};
+#define CONFIG_ENTRY_COUNT ((int)(sizeof(config_entries) / sizeof(config_entries[0])))
+
+// Largest configuration file (in bytes)
+#define MAX_CONFIG_FILE 4096
+char config_buffer[MAX_CONFIG_FILE];
+
+// Values parsed from the file, applied together once the whole file is read
+double staged_values[CONFIG_ENTRY_COUNT];
+bool staged[CONFIG_ENTRY_COUNT];
+int config_errors = 0;
+
+int getConfigCount() {
+  return CONFIG_ENTRY_COUNT;
+}
+
+const ConfigEntry& getConfigEntry(int index) {
+  return config_entries[index];
+}
+
+const ConfigEntry* findConfig(const char* name) {
+  for (int i = 0; i < CONFIG_ENTRY_COUNT; i++) {
+    if (strcmp(config_entries[i].name, name) == 0) {
+      return &config_entries[i];
+    }
+  }
+  return 0;
+}
+
+double getConfigValue(const ConfigEntry& entry) {
+  switch (entry.type) {
+  case config_int: return *(int*)entry.value;
+  case config_bool: return *(bool*)entry.value ? 1 : 0;
+  default: return *(double*)entry.value;
+  }
+}
+
+/*
+ * True if the value may be stored in the entry.
+ */
+bool validConfigValue(const ConfigEntry& entry, double value) {
+  if (!std::isfinite(value) || value < entry.min || value > entry.max) {
+    return false;
+  }
+  return entry.type == config_double || value == floor(value);
+}
+
+bool setConfigValue(const ConfigEntry& entry, double value) {
+  if (!validConfigValue(entry, value)) {
+    return false;
+  }
+  switch (entry.type) {
+  case config_int: *(int*)entry.value = (int)value; break;
+  case config_bool: *(bool*)entry.value = value != 0; break;
+  default: *(double*)entry.value = value; break;
+  }
+  return true;
+}
+
+// ============================================================================
+// FILE PARSING
+// ============================================================================
+
+/*
+ * Strips leading and trailing whitespace in place.
+ */
+char* trimConfigText(char* text) {
+  while (*text == ' ' || *text == '\t') {
+    text++;
+  }
+  char* end = text + strlen(text);
+  while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+    end--;
+  }
+  *end = 0;
+  return text;
+}
+
+bool parseConfigValue(const ConfigEntry& entry, const char* text, double& value) {
+  if (entry.type == config_bool) {
+    if (strcmp(text, "true") == 0) { value = 1; return true; }
+    if (strcmp(text, "false") == 0) { value = 0; return true; }
+  }
+  char* end;
+  value = strtod(text, &end);
+  return end != text && *end == 0;
+}
+
+bool loadConfig(const char* file, const char* profile) {
+  if (!Brain.SDcard.isInserted()) {
+    return false;
+  }
+  int length = Brain.SDcard.loadfile(file, (uint8_t*)config_buffer, MAX_CONFIG_FILE - 1);
+  if (length <= 0) {
+    return false;
+  }
+  config_buffer[length] = 0;
+  config_errors = 0;
+  for (int i = 0; i < CONFIG_ENTRY_COUNT; i++) {
+    staged[i] = false;
+  }
+
+  char active_profile[32] = "";
+  if (profile) {
+    strncpy(active_profile, profile, sizeof(active_profile) - 1);
+  }
+  bool in_section = false, section_active = false;
+
+  char* line = config_buffer;
+  while (line) {
+    char* next = strchr(line, '\n');
+    if (next) {
+      *next = 0;
+      next++;
+    }
+    char* comment = strchr(line, '#');
+    if (comment) {
+      *comment = 0;
+    }
+    line = trimConfigText(line);
+
+    if (*line == '[') {
+      // Profile section
+      char* close = strchr(line, ']');
+      if (close) {
+        *close = 0;
+      }
+      in_section = true;
+      section_active = strcmp(trimConfigText(line + 1), active_profile) == 0;
+    } else if (*line && (!in_section || section_active)) {
+      char* equals = strchr(line, '=');
+      if (!equals) {
+        config_errors++;
+      } else {
+        *equals = 0;
+        char* name = trimConfigText(line);
+        char* text = trimConfigText(equals + 1);
+        if (strcmp(name, "profile") == 0) {
+          if (!in_section && !profile) {
+            strncpy(active_profile, text, sizeof(active_profile) - 1);
+          }
+        } else {
+          const ConfigEntry* entry = findConfig(name);
+          double value;
+          if (entry && parseConfigValue(*entry, text, value) && validConfigValue(*entry, value)) {
+            int index = entry - config_entries;
+            staged_values[index] = value;
+            staged[index] = true;
+          } else {
+            config_errors++;
+          }
+        }
+      }
+    }
+    line = next;
+  }
+
+  for (int i = 0; i < CONFIG_ENTRY_COUNT; i++) {
+    if (staged[i]) {
+      setConfigValue(config_entries[i], staged_values[i]);
+    }
+  }
+  return true;
+}
+
+int getConfigErrors() {
+  return config_errors;
+}
+
+bool saveConfig(const char* file, const char* const* names, int name_count) {
+  if (!Brain.SDcard.isInserted()) {
+    return false;
+  }
+  int count = names ? name_count : CONFIG_ENTRY_COUNT;
+  int length = 0;
+  for (int i = 0; i < count; i++) {
+    const ConfigEntry* entry = names ? findConfig(names[i]) : &config_entries[i];
+    if (!entry) {
+      continue;
+    }
+    int remaining = MAX_CONFIG_FILE - length;
+    int written;
+    if (entry->type == config_bool) {
+      written = snprintf(config_buffer + length, remaining, "%s = %s\n", entry->name, getConfigValue(*entry) != 0 ? "true" : "false");
+    } else {
+      written = snprintf(config_buffer + length, remaining, "%s = %.9g\n", entry->name, getConfigValue(*entry));
+    }
+    if (written >= remaining) {
+      return false;
+    }
+    length += written;
+  }
+  return Brain.SDcard.savefile(file, (uint8_t*)config_buffer, length) == length;
+}
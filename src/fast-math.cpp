@@ -0,0 +1,109 @@
+#include "fast-math.h"
+
+#include <cmath>
+
+// ============================================================================
+// SINE AND COSINE
+// ============================================================================
+
+/*
+ * Sine using range reduction to [-pi/2, pi/2] and an odd Taylor polynomial
+ * evaluated in Horner form (up to x^15 for double, x^9 for float).
+ */
+double fastSin(double x) {
+  // Reduce to [-pi, pi]
+  x -= 2 * M_PI * floor(x * (0.5 / M_PI) + 0.5);
+  // Reduce to [-pi/2, pi/2] using sin(pi - x) = sin(x)
+  if (x > M_PI / 2) {
+    x = M_PI - x;
+  } else if (x < -M_PI / 2) {
+    x = -M_PI - x;
+  }
+  double x2 = x * x;
+  return x * (1 + x2 * (-1.0 / 6 + x2 * (1.0 / 120 + x2 * (-1.0 / 5040 + x2 * (1.0 / 362880 +
+         x2 * (-1.0 / 39916800 + x2 * (1.0 / 6227020800.0 + x2 * (-1.0 / 1307674368000.0))))))));
+}
+
+double fastCos(double x) {
+  return fastSin(x + M_PI / 2);
+}
+
+float fastSin(float x) {
+  const float pi = (float)M_PI;
+  x -= 2 * pi * floorf(x * (0.5f / pi) + 0.5f);
+  if (x > pi / 2) {
+    x = pi - x;
+  } else if (x < -pi / 2) {
+    x = -pi - x;
+  }
+  float x2 = x * x;
+  return x * (1 + x2 * (-1.0f / 6 + x2 * (1.0f / 120 + x2 * (-1.0f / 5040 + x2 * (1.0f / 362880)))));
+}
+
+float fastCos(float x) {
+  return fastSin(x + (float)M_PI / 2);
+}
+
+// ============================================================================
+// ARCTANGENT
+// ============================================================================
+
+/*
+ * Two-argument arctangent. The ratio is folded into [0, 1] by octant and, for
+ * double, further into [-tan(pi/8), tan(pi/8)] with atan(z) = pi/4 + atan((z-1)/(z+1))
+ * before an odd Taylor polynomial up to z^19.
+ */
+double fastAtan2(double y, double x) {
+  double abs_x = fabs(x), abs_y = fabs(y);
+  if (abs_x == 0 && abs_y == 0) {
+    return 0;
+  }
+  bool swap = abs_y > abs_x;
+  double z = swap ? abs_x / abs_y : abs_y / abs_x;
+  double base = 0;
+  if (z > 0.41421356237309503) {
+    z = (z - 1) / (z + 1);
+    base = M_PI / 4;
+  }
+  double z2 = z * z;
+  double angle = base + z * (1 + z2 * (-1.0 / 3 + z2 * (1.0 / 5 + z2 * (-1.0 / 7 + z2 * (1.0 / 9 +
+                 z2 * (-1.0 / 11 + z2 * (1.0 / 13 + z2 * (-1.0 / 15 + z2 * (1.0 / 17 + z2 * (-1.0 / 19))))))))));
+  if (swap) angle = M_PI / 2 - angle;
+  if (x < 0) angle = M_PI - angle;
+  return y < 0 ? -angle : angle;
+}
+
+/*
+ * Float arctangent using a minimax polynomial on [0, 1].
+ */
+float fastAtan2(float y, float x) {
+  const float pi = (float)M_PI;
+  float abs_x = fabsf(x), abs_y = fabsf(y);
+  if (abs_x == 0 && abs_y == 0) {
+    return 0;
+  }
+  bool swap = abs_y > abs_x;
+  float z = swap ? abs_x / abs_y : abs_y / abs_x;
+  float z2 = z * z;
+  float angle = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f + z2 * (-0.11643287f +
+                z2 * (0.05265332f + z2 * -0.01172120f)))));
+  if (swap) angle = pi / 2 - angle;
+  if (x < 0) angle = pi - angle;
+  return y < 0 ? -angle : angle;
+}
+
+// ============================================================================
+// HYPOTENUSE
+// ============================================================================
+
+/*
+ * Plain sqrt(x^2 + y^2). Field coordinates never come close to overflowing,
+ * so the scaling done by libm hypot is skipped and sqrt maps to VSQRT.
+ */
+double fastHypot(double x, double y) {
+  return sqrt(x * x + y * y);
+}
+
+float fastHypot(float x, float y) {
+  return sqrtf(x * x + y * y);
+}
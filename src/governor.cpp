@@ -0,0 +1,114 @@
+#include "vex.h"
+#include "governor.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+struct GovernedMotor {
+  vex::motor* motor;
+  bool chassis;
+  double ambient_temp; // Temperature at registration (in degrees Celsius)
+  double model_temp;  // Modeled winding temperature (in degrees Celsius)
+  double headroom;    // Predicted headroom before derating (in degrees Celsius)
+  double peak_power;  // Highest power seen (in watts)
+};
+GovernedMotor governed_motors[MAX_GOVERNED_MOTORS];
+int governed_motor_count = 0;
+
+double governor_scale = 1;
+double governor_margin = 100;
+
+// Thermal model: the winding heats with current squared and cools toward ambient.
+// Heating per amp squared (in degrees per second), about 0.3 degrees per second at the 2.5 A limit
+const double heat_per_amp_sq = 0.045;
+// Cooling time constant (in seconds)
+const double cooling_sec = 300;
+// Fraction of the gap to the measured temperature closed every sample (the sensor is coarse)
+const double measurement_gain = 0.02;
+// How far ahead the headroom is predicted (in seconds)
+const double lookahead_sec = 10;
+const double governor_dt = 0.1;
+
+void addGovernedMotor(vex::motor& motor, bool chassis) {
+  if (governed_motor_count >= MAX_GOVERNED_MOTORS) {
+    return;
+  }
+  double temp = motor.temperature(celsius);
+  GovernedMotor governed = { &motor, chassis, temp, temp, 100, 0 };
+  governed_motors[governed_motor_count] = governed;
+  governed_motor_count++;
+}
+
+double getGovernorScale() {
+  return thermal_governor ? governor_scale : 1;
+}
+
+double getGovernorMargin() {
+  return governor_margin;
+}
+
+double getMotorHeadroom(int index) {
+  if (index < 0 || index >= governed_motor_count) {
+    return 0;
+  }
+  return governed_motors[index].headroom;
+}
+
+/*
+ * governorLoop
+ * Every 100 msec advances each motor's thermal model with its current, pulls the model toward
+ * the measured temperature and predicts the temperature lookahead_sec ahead at the present load.
+ * The chassis scale falls linearly from 1 at governor_start_headroom to governor_min_scale at
+ * no headroom, so output drops gradually well before the firmware cuts current.
+ */
+void governorLoop() {
+  int report_tick = 0;
+  while (true) {
+    double chassis_headroom = 100, margin = 100;
+    for (int i = 0; i < governed_motor_count; i++) {
+      GovernedMotor& governed = governed_motors[i];
+      double current = governed.motor->current(amp);
+      double measured = governed.motor->temperature(celsius);
+      double power = governed.motor->power(watt);
+      if (power > governed.peak_power) {
+        governed.peak_power = power;
+      }
+
+      double rate = heat_per_amp_sq * current * current - (governed.model_temp - governed.ambient_temp) / cooling_sec;
+      governed.model_temp += rate * governor_dt;
+      governed.model_temp += measurement_gain * (measured - governed.model_temp);
+      if (governed.model_temp < measured) {
+        governed.model_temp = measured;
+      }
+
+      double predicted = governed.model_temp + (rate > 0 ? rate * lookahead_sec : 0);
+      governed.headroom = governor_derate_temp - predicted;
+      if (governed.headroom < margin) {
+        margin = governed.headroom;
+      }
+      if (governed.chassis && governed.headroom < chassis_headroom) {
+        chassis_headroom = governed.headroom;
+      }
+    }
+
+    double scale = 1;
+    if (chassis_headroom < governor_start_headroom) {
+      double fraction = chassis_headroom > 0 ? chassis_headroom / governor_start_headroom : 0;
+      scale = governor_min_scale + (1 - governor_min_scale) * fraction;
+    }
+    governor_scale = scale;
+    governor_margin = margin;
+
+    // Report the margin on the controller once a second
+    report_tick++;
+    if (governor_report && report_tick >= 10) {
+      report_tick = 0;
+      controller_1.Screen.setCursor(3, 1);
+      controller_1.Screen.print("heat %4.1fC x%.2f  ", margin, getGovernorScale());
+    }
+    wait(100, msec);
+  }
+}
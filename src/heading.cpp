@@ -0,0 +1,146 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "heading.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+bool heading_running = false;
+double corrected_heading = 0;
+double heading_bias_dps = 0;
+// Inertial rotation and time at headingLoop's last sample, or when the heading was last set
+double heading_prev_raw = 0, heading_prev_time = 0;
+// How long both sides of the chassis have been still (in seconds)
+double heading_still_time = 0;
+
+// Chassis is considered still below this speed (in rpm) ...
+const double still_velocity_rpm = 1;
+// ... once it has been below it for this long (in seconds)
+const double still_settle_sec = 0.3;
+// Fraction of each still sample blended into the bias estimate
+const double bias_gain = 0.01;
+// Rates above this while still mean the robot is being pushed, not gyro bias (in degrees per second)
+const double max_bias_dps = 2;
+
+/*
+ * Whether rotation since the last sample is gyro bias: the chassis has been still long
+ * enough and the rate is below max_bias_dps (faster means the robot is being pushed).
+ * - delta: Raw rotation since the last sample (in degrees).
+ * - dt: Time since the last sample (in seconds).
+ */
+bool rotationIsBias(double delta, double dt) {
+  return heading_still_time > still_settle_sec && fabs(delta / dt) < max_bias_dps;
+}
+
+double getCorrectedHeading() {
+  double raw = inertial_sensor.rotation(degrees);
+  if (!heading_running) {
+    return raw * inertial_scale;
+  }
+  // Corrected rotation since headingLoop's last sample, so odometry sub-steps between its
+  // 10 msec samples see the heading change as it happens
+  double dt = (Brain.timer(msec) - heading_prev_time) / 1000.0;
+  double delta = raw - heading_prev_raw;
+  if (dt <= 0 || rotationIsBias(delta, dt)) {
+    return corrected_heading;
+  }
+  return corrected_heading + (delta - heading_bias_dps * dt) * inertial_scale;
+}
+
+void setCorrectedHeading(double heading_deg) {
+  corrected_heading = heading_deg;
+  // Rotation before now is part of the new heading, headingLoop integrates from here
+  heading_prev_raw = inertial_sensor.rotation(degrees);
+  heading_prev_time = Brain.timer(msec);
+}
+
+double getHeadingBias() {
+  return heading_bias_dps;
+}
+
+/*
+ * headingLoop
+ * Integrates the inertial rotation every 10 ms with the bias removed and inertial_scale applied
+ * (getCorrectedHeading adds the rotation since the last sample).
+ * While both sides of the chassis are still, rotation slower than max_bias_dps updates the bias
+ * and the heading is held; faster rotation (the robot being pushed) is integrated.
+ */
+void headingLoop() {
+  heading_prev_raw = inertial_sensor.rotation(degrees);
+  heading_prev_time = Brain.timer(msec);
+  heading_still_time = 0;
+  corrected_heading = heading_prev_raw * inertial_scale;
+  heading_running = true;
+
+  while (true) {
+    double raw = inertial_sensor.rotation(degrees);
+    double now = Brain.timer(msec);
+    double dt = (now - heading_prev_time) / 1000.0;
+    double delta = raw - heading_prev_raw;
+    heading_prev_raw = raw;
+    heading_prev_time = now;
+    if (dt <= 0) {
+      wait(10, msec);
+      continue;
+    }
+
+    bool still = fabs(left_chassis.velocity(rpm)) < still_velocity_rpm && fabs(right_chassis.velocity(rpm)) < still_velocity_rpm;
+    heading_still_time = still ? heading_still_time + dt : 0;
+
+    // While still, slow rotation is bias and the heading is held; faster rotation means
+    // the robot is being pushed and counts as a turn
+    if (rotationIsBias(delta, dt)) {
+      heading_bias_dps += bias_gain * (delta / dt - heading_bias_dps);
+    } else {
+      corrected_heading += (delta - heading_bias_dps * dt) * inertial_scale;
+    }
+    wait(10, msec);
+  }
+}
+
+double calibrateHeadingScale(int rotations, double voltage) {
+  double target = rotations * 360.0;
+  double start_raw = inertial_sensor.rotation(degrees);
+  double start_heading = getCorrectedHeading();
+  double start_time = Brain.timer(msec);
+
+  // Spin clockwise, slowing down for the last quarter turn
+  while (inertial_sensor.rotation(degrees) - start_raw < target - 5) {
+    double remaining = target - (inertial_sensor.rotation(degrees) - start_raw);
+    double output = remaining < 90 ? fmax(voltage * remaining / 90, 2) : voltage;
+    driveChassis(output, -output);
+    wait(10, msec);
+  }
+  stopChassis(brake);
+  wait(300, msec);
+
+  // Driver lines the robot back up with the reference
+  Brain.Screen.clearScreen();
+  Brain.Screen.setCursor(1, 1);
+  Brain.Screen.print("Align with reference, press A");
+  while (!controller_1.ButtonA.pressing()) {
+    double turn = controller_1.Axis1.value() * 0.02;
+    driveChassis(turn, -turn);
+    wait(10, msec);
+  }
+  stopChassis(brake);
+  wait(300, msec);
+
+  double elapsed = (Brain.timer(msec) - start_time) / 1000.0;
+  double measured = inertial_sensor.rotation(degrees) - start_raw - heading_bias_dps * elapsed;
+  if (fabs(measured) < 1) {
+    return inertial_scale;
+  }
+  inertial_scale = target / measured;
+  resetOdometryHeading(start_heading + target);
+
+  Brain.Screen.newLine();
+  Brain.Screen.print("inertial_scale = %.5f", inertial_scale);
+  controller_1.Screen.clearLine(1);
+  controller_1.Screen.setCursor(1, 1);
+  controller_1.Screen.print("scale %.5f", inertial_scale);
+  return inertial_scale;
+}
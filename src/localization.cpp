@@ -0,0 +1,238 @@
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "fast-math.h"
+#include "path-planner.h"
+#include "localization.h"
+
+#include <cmath>
+#include <stdint.h>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// Particles, laid out structure-of-arrays so the per-particle loops are
+// straight-line float code without library calls, which the compiler can vectorize.
+float particle_x[LOCALIZATION_PARTICLES];
+float particle_y[LOCALIZATION_PARTICLES];
+float particle_weight[LOCALIZATION_PARTICLES];
+float resample_x[LOCALIZATION_PARTICLES];
+float resample_y[LOCALIZATION_PARTICLES];
+
+struct LocalizationSensor {
+  vex::distance* sensor;
+  float offset_x, offset_y, angle_rad;
+};
+LocalizationSensor localization_sensors[MAX_LOCALIZATION_SENSORS];
+int localization_sensor_count = 0;
+
+bool localization_enabled = false;
+bool localization_initialized = false;
+
+// Odometry pose at the last filter update, to measure motion between updates.
+double localization_prev_x = 0, localization_prev_y = 0;
+
+// Motion noise per inch traveled and per update (in inches).
+const float motion_noise_per_in = 0.05f;
+const float motion_noise_floor = 0.02f;
+// Distance sensor noise: constant part plus a fraction of the range.
+const float sensor_noise_in = 0.6f;
+const float sensor_noise_ratio = 0.03f;
+// Valid distance sensor range (in inches).
+const float max_sensor_range_in = 78;
+
+uint32_t random_state = 2463534242u;
+
+// ============================================================================
+// RANDOM NUMBERS
+// ============================================================================
+
+// xorshift32, uniform in [0, 1)
+float randomUniform() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return (random_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// Approximately normal with unit variance (sum of four uniforms).
+float randomGaussian() {
+  return (randomUniform() + randomUniform() + randomUniform() + randomUniform() - 2.0f) * 1.7320508f;
+}
+
+/*
+ * exp(-x) for x >= 0 as (1 + x/256)^-256: a division and eight squarings, with no
+ * library call or branch to keep the weighting loop from vectorizing. Within 0.0011 of expf.
+ */
+inline float expNegative(float x) {
+  float y = 1.0f / (1.0f + x * (1.0f / 256));
+  for (int i = 0; i < 8; i++) {
+    y *= y;
+  }
+  return y;
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+void addLocalizationSensor(vex::distance& sensor, double offset_x_in, double offset_y_in, double angle_deg) {
+  if (localization_sensor_count >= MAX_LOCALIZATION_SENSORS) {
+    return;
+  }
+  localization_sensors[localization_sensor_count].sensor = &sensor;
+  localization_sensors[localization_sensor_count].offset_x = offset_x_in;
+  localization_sensors[localization_sensor_count].offset_y = offset_y_in;
+  localization_sensors[localization_sensor_count].angle_rad = degToRad(angle_deg);
+  localization_sensor_count++;
+}
+
+void resetLocalization(double x, double y, double spread_in) {
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    particle_x[i] = x + randomGaussian() * spread_in;
+    particle_y[i] = y + randomGaussian() * spread_in;
+    particle_weight[i] = 1.0f / LOCALIZATION_PARTICLES;
+  }
+  x_pos = x;
+  y_pos = y;
+  localization_prev_x = x;
+  localization_prev_y = y;
+  localization_initialized = true;
+}
+
+void setLocalizationEnabled(bool enabled) {
+  if (enabled && !localization_initialized) {
+    resetLocalization(x_pos, y_pos);
+  }
+  localization_enabled = enabled;
+}
+
+// ============================================================================
+// FILTER STEPS
+// ============================================================================
+
+/*
+ * Moves every particle by the odometry displacement plus noise that grows with the distance traveled.
+ */
+void propagateParticles(float delta_x, float delta_y) {
+  float noise = motion_noise_floor + motion_noise_per_in * controlHypot(delta_x, delta_y);
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    particle_x[i] += delta_x + randomGaussian() * noise;
+    particle_y[i] += delta_y + randomGaussian() * noise;
+  }
+}
+
+/*
+ * Multiplies particle weights by the likelihood of one distance reading, ray cast
+ * against the field perimeter. A uniform floor keeps game objects in front of the
+ * sensor from collapsing the filter.
+ */
+void weightParticles(const LocalizationSensor& mount, float heading_rad, float measured_in) {
+  float sin_heading = controlSin(heading_rad), cos_heading = controlCos(heading_rad);
+  // Sensor offset and beam direction in the field frame (heading is clockwise from +y)
+  float offset_x = mount.offset_x * cos_heading + mount.offset_y * sin_heading;
+  float offset_y = -mount.offset_x * sin_heading + mount.offset_y * cos_heading;
+  float beam_x = controlSin(heading_rad + mount.angle_rad);
+  float beam_y = controlCos(heading_rad + mount.angle_rad);
+  float wall = FIELD_SIZE_IN / 2.0f;
+  float wall_x = beam_x > 0 ? wall : -wall;
+  float wall_y = beam_y > 0 ? wall : -wall;
+  float inverse_x = fabsf(beam_x) > 1e-6f ? 1.0f / beam_x : 1e6f;
+  float inverse_y = fabsf(beam_y) > 1e-6f ? 1.0f / beam_y : 1e6f;
+  float sigma = sensor_noise_in + sensor_noise_ratio * measured_in;
+  float inverse_variance = 0.5f / (sigma * sigma);
+
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    float t_x = (wall_x - (particle_x[i] + offset_x)) * inverse_x;
+    float t_y = (wall_y - (particle_y[i] + offset_y)) * inverse_y;
+    float expected = t_x < t_y ? t_x : t_y;
+    float error = measured_in - expected;
+    particle_weight[i] *= 0.05f + expNegative(error * error * inverse_variance);
+  }
+}
+
+/*
+ * Normalizes the weights and resamples (low variance) when the effective
+ * particle count falls below half. Returns false if all weights vanished.
+ */
+bool resampleParticles() {
+  float total = 0;
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    total += particle_weight[i];
+  }
+  if (total <= 0 || total != total) {
+    return false;
+  }
+  float inverse_total = 1.0f / total, sum_sq = 0;
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    particle_weight[i] *= inverse_total;
+    sum_sq += particle_weight[i] * particle_weight[i];
+  }
+  if (1.0f / sum_sq >= LOCALIZATION_PARTICLES / 2) {
+    return true;
+  }
+
+  float step = 1.0f / LOCALIZATION_PARTICLES;
+  float position = randomUniform() * step;
+  float cumulative = particle_weight[0];
+  int source = 0;
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    while (position > cumulative && source < LOCALIZATION_PARTICLES - 1) {
+      source++;
+      cumulative += particle_weight[source];
+    }
+    resample_x[i] = particle_x[source];
+    resample_y[i] = particle_y[source];
+    position += step;
+  }
+  for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+    particle_x[i] = resample_x[i];
+    particle_y[i] = resample_y[i];
+    particle_weight[i] = step;
+  }
+  return true;
+}
+
+// ============================================================================
+// LOCALIZATION TASK
+// ============================================================================
+
+/*
+ * localizationLoop
+ * Every 10 ms: moves the particles by the odometry displacement, weights them with
+ * each distance sensor, resamples and publishes the weighted mean to x_pos/y_pos.
+ */
+void localizationLoop() {
+  while (true) {
+    if (localization_enabled && localization_sensor_count > 0) {
+      float delta_x = x_pos - localization_prev_x;
+      float delta_y = y_pos - localization_prev_y;
+      propagateParticles(delta_x, delta_y);
+
+      float heading_rad = degToRad(getInertialHeading());
+      for (int i = 0; i < localization_sensor_count; i++) {
+        float measured_in = localization_sensors[i].sensor->objectDistance(mm) / 25.4f;
+        if (measured_in > 0 && measured_in < max_sensor_range_in) {
+          weightParticles(localization_sensors[i], heading_rad, measured_in);
+        }
+      }
+
+      if (resampleParticles()) {
+        float mean_x = 0, mean_y = 0;
+        for (int i = 0; i < LOCALIZATION_PARTICLES; i++) {
+          mean_x += particle_x[i] * particle_weight[i];
+          mean_y += particle_y[i] * particle_weight[i];
+        }
+        x_pos = mean_x;
+        y_pos = mean_y;
+      } else {
+        // Every particle disagreed with the sensors, start over around odometry
+        resetLocalization(x_pos, y_pos, 4);
+      }
+      localization_prev_x = x_pos;
+      localization_prev_y = y_pos;
+    }
+    wait(10, msec);
+  }
+}
@@ -0,0 +1,214 @@
+#include "vex.h"
+#include "utils.h"
+#include "pid.h"
+#include "mechanism.h"
+#include "battery.h"
+
+#include <cmath>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+Mechanism* mechanisms[MAX_MECHANISMS];
+int mechanism_count = 0;
+
+// Control period of the mechanism task (in seconds).
+const double mechanism_dt = 0.01;
+
+// ============================================================================
+// MECHANISM CLASS
+// ============================================================================
+
+// Constructors
+Mechanism::Mechanism(vex::motor& new_motor, double new_kp, double new_ki, double new_kd)
+  : pid(new_kp, new_ki, new_kd), motor(&new_motor), motors(0) {
+  initialize();
+}
+
+Mechanism::Mechanism(vex::motor_group& new_motors, double new_kp, double new_ki, double new_kd)
+  : pid(new_kp, new_ki, new_kd), motor(0), motors(&new_motors) {
+  initialize();
+}
+
+void Mechanism::initialize() {
+  target = 0;
+  setpoint = 0;
+  setpoint_velocity = 0;
+  profile_reset = true;
+  kg = 0;
+  horizontal_position = 0;
+  degrees_per_motor_degree = 1;
+  ks = 0;
+  max_velocity = 0;
+  max_accel = 0;
+  max_output = 12;
+  tolerance = 1;
+  enabled = true;
+
+  pid.setIntegralMax(0);
+  pid.setIntegralRange(5);
+  pid.setSmallBigErrorTolerance(tolerance, tolerance * 3);
+  pid.setSmallBigErrorDuration(50, 250);
+  pid.setDerivativeTolerance(100);
+}
+
+void Mechanism::setTarget(double new_target) {
+  if (new_target == target && !profile_reset) {
+    return;
+  }
+  // The PID keeps its error history across targets; only the
+  // profile restarts from the current position.
+  target = new_target;
+  profile_reset = true;
+}
+
+double Mechanism::getTarget() {
+  return target;
+}
+
+void Mechanism::setGravityFeedforward(double new_kg, double new_horizontal_position, double new_degrees_per_motor_degree) {
+  kg = new_kg;
+  horizontal_position = new_horizontal_position;
+  degrees_per_motor_degree = new_degrees_per_motor_degree;
+}
+
+void Mechanism::setFrictionFeedforward(double new_ks) {
+  ks = new_ks;
+}
+
+void Mechanism::setMotionProfile(double new_max_velocity, double new_max_accel) {
+  max_velocity = new_max_velocity;
+  max_accel = new_max_accel;
+}
+
+void Mechanism::setMaxOutput(double new_max_output) {
+  max_output = new_max_output;
+}
+
+void Mechanism::setTolerance(double new_tolerance) {
+  tolerance = new_tolerance;
+  pid.setSmallBigErrorTolerance(tolerance, tolerance * 3);
+}
+
+void Mechanism::setEnabled(bool new_enabled) {
+  if (new_enabled && !enabled) {
+    // Resume from wherever the motor was left.
+    pid.reset();
+    profile_reset = true;
+  }
+  enabled = new_enabled;
+}
+
+bool Mechanism::isEnabled() {
+  return enabled;
+}
+
+bool Mechanism::targetArrived() {
+  return setpoint == target && fabs(target - getPosition()) <= tolerance;
+}
+
+double Mechanism::getPosition() {
+  if (motors) {
+    return motors->position(degrees);
+  }
+  return motor->position(degrees);
+}
+
+void Mechanism::spin(double output) {
+  output = compensateVoltage(output);
+  if (motors) {
+    motors->spin(fwd, output, volt);
+  } else {
+    motor->spin(fwd, output, volt);
+  }
+}
+
+/*
+ * Runs one control step: advances the profiled setpoint towards the target,
+ * updates the persistent PID and adds the feedforward terms.
+ */
+void Mechanism::update() {
+  double position = getPosition();
+
+  if (profile_reset) {
+    // Start the profile from the current state of the mechanism.
+    setpoint = max_velocity > 0 ? position : target;
+    setpoint_velocity = 0;
+    profile_reset = false;
+  }
+
+  if (max_velocity > 0 && setpoint != target) {
+    // Trapezoidal profile: accelerate up to max_velocity, then
+    // decelerate so the setpoint stops exactly on the target.
+    double remaining = target - setpoint;
+    double direction = remaining > 0 ? 1 : -1;
+    double stop_velocity = max_accel > 0 ? sqrt(2 * max_accel * fabs(remaining)) : max_velocity;
+    double velocity = fabs(setpoint_velocity) + (max_accel > 0 ? max_accel * mechanism_dt : max_velocity);
+    if (velocity > max_velocity) velocity = max_velocity;
+    if (velocity > stop_velocity) velocity = stop_velocity;
+    setpoint_velocity = velocity * direction;
+    if (fabs(setpoint_velocity * mechanism_dt) >= fabs(remaining)) {
+      setpoint = target;
+      setpoint_velocity = 0;
+    } else {
+      setpoint += setpoint_velocity * mechanism_dt;
+    }
+  } else {
+    setpoint = target;
+  }
+
+  pid.setTarget(setpoint);
+  double output = pid.update(position);
+
+  // Feedforward terms
+  if (kg != 0) {
+    output += kg * cos(degToRad((position - horizontal_position) * degrees_per_motor_degree));
+  }
+  if (ks != 0 && fabs(target - position) > tolerance) {
+    output += ks * pid.sign(target - position);
+  }
+
+  if (output > max_output) output = max_output;
+  else if (output < -max_output) output = -max_output;
+  spin(output);
+}
+
+// ============================================================================
+// MECHANISM CONTROL TASK
+// ============================================================================
+
+/*
+ * Adds a mechanism to the shared control task.
+ * - mechanism: Mechanism to run every control tick.
+ */
+void registerMechanism(Mechanism& mechanism) {
+  if (mechanism_count >= MAX_MECHANISMS) {
+    return;
+  }
+  mechanisms[mechanism_count] = &mechanism;
+  mechanism_count++;
+}
+
+int getMechanismCount() {
+  return mechanism_count;
+}
+
+Mechanism& getMechanism(int index) {
+  return *mechanisms[index];
+}
+
+/*
+ * mechanismControlLoop
+ * Updates every registered and enabled mechanism from a single thread.
+ * Started once in runPreAutonomous; change targets with Mechanism::setTarget.
+ */
+void mechanismControlLoop() {
+  while (true) {
+    for (int i = 0; i < mechanism_count; i++) {
+      if (mechanisms[i]->isEnabled()) {
+        mechanisms[i]->update();
+      }
+    }
+    wait(10, msec);
+  }
+}
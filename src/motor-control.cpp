@@ -1,6 +1,13 @@
 #include "vex.h"
 #include "utils.h"
 #include "pid.h"
+#include "fast-math.h"
+#include "trajectory.h"
+#include "heading.h"
+#include "pose-history.h"
+#include "battery.h"
+#include "governor.h"
+#include "slip.h"
 #include <ctime>
 #include <cmath>
 #include "motor-control.h"
@@ -15,6 +22,28 @@ double prev_left_output = 0, prev_right_output = 0;
 double x_pos = 0, y_pos = 0;
 double correct_angle = 0;
 
+// Sensor readings the odometry trackers measure from after a heading reset
+struct OdometryReadings {
+  double heading_rad, left_deg, right_deg, vertical_deg, right_vertical_deg, horizontal_deg;
+};
+// Heading resets (resetOdometryHeading) so far, and the readings at the last one
+int odometry_resets = 0;
+OdometryReadings odometry_reset_readings;
+// Odometry steps since the pose was last recorded in the pose history
+int odometry_steps_unrecorded = 0;
+
+// Motion markers staged for the next motion primitive
+#define MAX_MOTION_MARKERS 8
+enum MarkerType { marker_distance, marker_percent, marker_near_target };
+struct MotionMarker {
+  MarkerType type;
+  double value;
+  void (*action)();
+  bool fired;
+};
+MotionMarker motion_markers[MAX_MOTION_MARKERS];
+int motion_marker_count = 0;
+
 // ============================================================================
 // CHASSIS CONTROL FUNCTIONS
 // ============================================================================
@@ -25,9 +54,21 @@ double correct_angle = 0;
  * - right_power: Voltage for the right side (in volts).
  */
 void driveChassis(double left_power, double right_power) {
+  // Traction control backs off while the wheels slip
+  left_power *= getTractionScale();
+  right_power *= getTractionScale();
+
+  // Rescaled to the battery, then scaled down together to the thermal governor's cap (12 volts
+  // when cool), so the turn ratio is kept and a drained battery can't push a hot motor past it
+  double battery_scale = getBatteryScale();
+  double cap = 12 * getGovernorScale();
+  double compensated = fmax(fabs(left_power), fabs(right_power)) * battery_scale;
+  if (compensated > cap) {
+    battery_scale *= cap / compensated;
+  }
   // Spin left and right chassis motors with specified voltages
-  left_chassis.spin(fwd, left_power, voltageUnits::volt);
-  right_chassis.spin(fwd, right_power, voltageUnits::volt);
+  left_chassis.spin(fwd, left_power * battery_scale, voltageUnits::volt);
+  right_chassis.spin(fwd, right_power * battery_scale, voltageUnits::volt);
 }
 
 /*
@@ -70,22 +111,23 @@ double getRightRotationDegree() {
  * - angle: The target angle to normalize.
  */
 double normalizeTarget(double angle) {
-  // Adjust angle to be within +/-180 degrees of the inertial sensor's rotation
-  if (angle - inertial_sensor.rotation() > 180) {
-    while (angle - inertial_sensor.rotation() > 180) angle -= 360;
-  } else if (angle - inertial_sensor.rotation() < -180) {
-    while (angle - inertial_sensor.rotation() < -180) angle += 360;
+  // Adjust angle to be within +/-180 degrees of the corrected heading
+  double heading = getInertialHeading();
+  if (angle - heading > 180) {
+    while (angle - heading > 180) angle -= 360;
+  } else if (angle - heading < -180) {
+    while (angle - heading < -180) angle += 360;
   }
   return angle;
 }
 
 /*
- * Returns the current inertial sensor heading in degrees.
+ * Returns the current inertial sensor heading in degrees, corrected for gyro bias and scale.
  * - normalize: If true, normalizes the heading (not used in this implementation).
  */
 double getInertialHeading(bool normalize) {
-  // Get inertial sensor rotation in degrees
-  return inertial_sensor.rotation(degrees);
+  // Get bias and scale corrected rotation in degrees
+  return getCorrectedHeading();
 }
 
 // ============================================================================
@@ -98,7 +140,8 @@ double getInertialHeading(bool normalize) {
  * - right_output: Reference to right output voltage.
  * - min_output: Minimum allowed output voltage.
  */
-void scaleToMin(double& left_output, double& right_output, double min_output) {
+template <typename Scalar>
+void scaleToMin(Scalar& left_output, Scalar& right_output, Scalar min_output) {
   // Scale outputs to ensure minimum voltage is met for both sides
   if (fabs(left_output) <= fabs(right_output) && left_output < min_output && left_output > 0) {
     right_output = right_output / left_output * min_output;
@@ -121,7 +164,8 @@ void scaleToMin(double& left_output, double& right_output, double min_output) {
  * - right_output: Reference to right output voltage.
  * - max_output: Maximum allowed output voltage.
  */
-void scaleToMax(double& left_output, double& right_output, double max_output) {
+template <typename Scalar>
+void scaleToMax(Scalar& left_output, Scalar& right_output, Scalar max_output) {
   // Scale outputs to ensure maximum voltage is not exceeded for both sides
   if (fabs(left_output) >= fabs(right_output) && left_output > max_output) {
     right_output = right_output / left_output * max_output;
@@ -138,10 +182,359 @@ void scaleToMax(double& left_output, double& right_output, double max_output) {
   }
 }
 
+// ============================================================================
+// MOTION MARKERS
+// ============================================================================
+
+/*
+ * Stages a marker for the next motion primitive. Motions that track progress (driveTo,
+ * moveToPoint, boomerang, followTrajectory, arcTo) run the action from their control loop
+ * the first tick its condition holds, so mechanism actions overlap with driving without
+ * splitting the move. Every primitive discards the markers that have not fired when it ends.
+ */
+void addMarker(MarkerType type, double value, void (*action)()) {
+  if (motion_marker_count >= MAX_MOTION_MARKERS) {
+    return;
+  }
+  motion_markers[motion_marker_count].type = type;
+  motion_markers[motion_marker_count].value = value;
+  motion_markers[motion_marker_count].action = action;
+  motion_markers[motion_marker_count].fired = false;
+  motion_marker_count++;
+}
+
+/*
+ * Runs action once the robot has traveled distance_in inches during the next motion.
+ */
+void atDistance(double distance_in, void (*action)()) {
+  addMarker(marker_distance, fabs(distance_in), action);
+}
+
+/*
+ * Runs action once the next motion is percent (0-100) complete.
+ */
+void atPercent(double percent, void (*action)()) {
+  addMarker(marker_percent, percent, action);
+}
+
+/*
+ * Runs action once the robot is within radius_in inches of the next motion's target.
+ */
+void nearTarget(double radius_in, void (*action)()) {
+  addMarker(marker_near_target, fabs(radius_in), action);
+}
+
+/*
+ * Discards all staged markers.
+ */
+void clearMarkers() {
+  motion_marker_count = 0;
+}
+
+/*
+ * Completion (0-100) of done out of total for percent markers. A motion with nothing to do is complete.
+ */
+double markerPercent(double done, double total) {
+  return total > 0 ? done / total * 100 : 100;
+}
+
+/*
+ * Fires any staged markers whose condition is met. Called every control tick.
+ * - traveled_in: Distance traveled since the start of the motion (in inches).
+ * - remaining_in: Distance left to the target (in inches).
+ * - percent: Completion of the motion (0-100).
+ */
+void updateMarkers(double traveled_in, double remaining_in, double percent) {
+  for (int i = 0; i < motion_marker_count; i++) {
+    MotionMarker& marker = motion_markers[i];
+    if (marker.fired) continue;
+    if ((marker.type == marker_distance && traveled_in >= marker.value) ||
+        (marker.type == marker_percent && percent >= marker.value) ||
+        (marker.type == marker_near_target && remaining_in <= marker.value)) {
+      marker.fired = true;
+      marker.action();
+    }
+  }
+}
+
+// ============================================================================
+// CONTROL LOOP ENGINE
+// ============================================================================
+
+// State shared by the policies of one motion during a control tick.
+struct ControlState {
+  double heading;                   // Inertial heading this tick (in degrees)
+  double target_heading;            // Heading the output map steers to (in degrees)
+  double left_output, right_output; // Side outputs (in volts)
+  bool arrived;                     // Controller settled on its target
+  bool passed;                      // Target reached or passed (ends a chained motion)
+  bool crossed;                     // Motion ends now (exit line crossed, path finished)
+};
+
+MotionResult last_motion = { 0, 0, false };
+
+/*
+ * runControlLoop
+ * The control loop behind every motion primitive, assembled at compile time from four policies.
+ * Every 10 msec:
+ * - error_source.measure(state): reads the sensors into the heading and target errors (and fires motion markers).
+ * - exit_policy.done(state): ends the motion once settled (or passed, when chaining).
+ * - output_map.compute(state, chain): turns the errors into side outputs; the chain policy keeps them above min_output when chaining.
+ * - chain.limit(left, right): max output and slew limits.
+ * - output_map.apply(state): drives the motors.
+ * - time_limit_msec: Maximum time allowed for the motion (in milliseconds).
+ */
+template <typename ErrorSource, typename OutputMap, typename ExitPolicy, typename ChainPolicy>
+void runControlLoop(ErrorSource& error_source, OutputMap& output_map, ExitPolicy exit_policy, ChainPolicy& chain, double time_limit_msec) {
+  ControlState state = { getInertialHeading(), getInertialHeading(), 0, 0, false, false, false };
+  double start_time = Brain.timer(msec);
+  last_motion.ticks = 0;
+  last_motion.timed_out = true;
+
+  while (Brain.timer(msec) - start_time <= time_limit_msec) {
+    error_source.measure(state);
+    if (state.crossed || exit_policy.done(state)) {
+      last_motion.timed_out = false;
+      break;
+    }
+    output_map.compute(state, chain);
+    if (state.crossed) {
+      last_motion.timed_out = false;
+      break;
+    }
+    chain.limit(state.left_output, state.right_output);
+    output_map.apply(state);
+    last_motion.ticks++;
+    wait(10, msec);
+  }
+  last_motion.elapsed_msec = Brain.timer(msec) - start_time;
+}
+
+/*
+ * Prepares the chassis for a motion primitive.
+ */
+void beginMotion() {
+  stopChassis(vex::brakeType::coast);
+  is_turning = true;
+}
+
+/*
+ * Ends a motion primitive. When the motion stops the robot, the chassis holds and the slew
+ * history is cleared; when chaining, the last outputs keep running into the next motion.
+ * Staged markers are consumed either way.
+ */
+void endMotion(bool exit) {
+  if (exit) {
+    prev_left_output = 0;
+    prev_right_output = 0;
+    stopChassis(vex::hold);
+  }
+  clearMarkers();
+  is_turning = false;
+}
+
+// Exit policy: settles on the controller, or when chaining (exit == false) ends once the target is passed.
+struct SettleOrPassExit {
+  bool exit;
+  bool done(const ControlState& state) { return exit ? state.arrived : state.passed; }
+};
+
+// Exit policy: settles on the controller, even when chaining.
+struct SettleExit {
+  bool done(const ControlState& state) { return state.arrived; }
+};
+
+// Exit policy: like SettleOrPassExit, but settling also needs the heading within tolerance_deg of heading_deg.
+struct SettleAtHeadingExit {
+  bool exit;
+  double heading_deg, tolerance_deg;
+  bool done(const ControlState& state) {
+    return exit ? state.arrived && fabs(heading_deg - state.heading) <= tolerance_deg : state.passed;
+  }
+};
+
+// Exit policy: runs until the motion reports it has crossed its exit line (or time runs out).
+struct CrossingExit {
+  bool done(const ControlState& state) { return false; }
+};
+
+/*
+ * DriveChain
+ * Chain policy for driving primitives. When chaining (exit == false) dir_change_start and
+ * dir_change_end relax the slew limits and keep the base output above min_output so the
+ * robot carries its speed into the next motion.
+ */
+struct DriveChain {
+  double max_output, max_slew_fwd, max_slew_rev;
+  bool min_speed, slew;
+
+  // No minimum output, and the same slew limit both ways (none when max_slew is 0).
+  DriveChain(double new_max_output, double max_slew = 0)
+    : max_output(new_max_output), max_slew_fwd(max_slew), max_slew_rev(max_slew), min_speed(false), slew(max_slew > 0) {}
+
+  DriveChain(int drive_direction, bool exit, double new_max_output, bool new_slew = true)
+    : max_output(new_max_output), min_speed(false), slew(new_slew) {
+    max_slew_fwd = drive_direction > 0 ? max_slew_accel_fwd : max_slew_decel_rev;
+    max_slew_rev = drive_direction > 0 ? max_slew_decel_fwd : max_slew_accel_rev;
+    if(!exit) {
+      // Adjust slew rates and min speed for chaining
+      if(!dir_change_start && dir_change_end) {
+        max_slew_fwd = drive_direction > 0 ? 24 : max_slew_decel_rev;
+        max_slew_rev = drive_direction > 0 ? max_slew_decel_fwd : 24;
+      }
+      if(dir_change_start && !dir_change_end) {
+        max_slew_fwd = drive_direction > 0 ? max_slew_accel_fwd : 24;
+        max_slew_rev = drive_direction > 0 ? 24 : max_slew_accel_rev;
+        min_speed = true;
+      }
+      if(!dir_change_start && !dir_change_end) {
+        max_slew_fwd = 24;
+        max_slew_rev = 24;
+        min_speed = true;
+      }
+    }
+  }
+
+  // Minimum Output Check, applied to the base output before heading correction
+  void minimum(double& left_output, double& right_output) {
+    if(min_speed) {
+      scaleToMin(left_output, right_output, min_output);
+    }
+  }
+
+  void limit(double& left_output, double& right_output) {
+    // Max Output Check
+    scaleToMax(left_output, right_output, max_output);
+    if(!slew) {
+      return;
+    }
+
+    // Max Acceleration/Deceleration Check. The thermal governor tightens only the limits that
+    // speed a side up (away from zero); braking keeps its rate so a hot robot doesn't overshoot
+    double governor = getGovernorScale();
+    double left_fwd = max_slew_fwd * (prev_left_output >= 0 ? governor : 1), left_rev = max_slew_rev * (prev_left_output <= 0 ? governor : 1);
+    double right_fwd = max_slew_fwd * (prev_right_output >= 0 ? governor : 1), right_rev = max_slew_rev * (prev_right_output <= 0 ? governor : 1);
+    if(prev_left_output - left_output > left_rev) {
+      left_output = prev_left_output - left_rev;
+    }
+    if(prev_right_output - right_output > right_rev) {
+      right_output = prev_right_output - right_rev;
+    }
+    if(left_output - prev_left_output > left_fwd) {
+      left_output = prev_left_output + left_fwd;
+    }
+    if(right_output - prev_right_output > right_fwd) {
+      right_output = prev_right_output + right_fwd;
+    }
+    prev_left_output = left_output;
+    prev_right_output = right_output;
+  }
+};
+
+/*
+ * TurnChain
+ * Chain policy for turns and swings, which drive a single effort. When chaining the effort
+ * never drops below min_output; it is always clamped to +/-max_output.
+ */
+struct TurnChain {
+  double max_output;
+  bool min_speed;
+
+  void minimum(double& left_output, double& right_output) {
+    if(min_speed) {
+      if(left_output < min_output) left_output = min_output;
+      if(right_output < min_output) right_output = min_output;
+    }
+  }
+
+  void limit(double& left_output, double& right_output) {
+    if(left_output > max_output) left_output = max_output;
+    else if(left_output < -max_output) left_output = -max_output;
+    if(right_output > max_output) right_output = max_output;
+    else if(right_output < -max_output) right_output = -max_output;
+  }
+};
+
+/*
+ * HeadingTrace
+ * Plots the heading against the target on the Brain screen during turns and swings.
+ */
+struct HeadingTrace {
+  double draw_amplifier, previous_heading;
+  int index;
+
+  HeadingTrace(double target) : draw_amplifier(230 / fabs(target)), previous_heading(0), index(1) {
+    // Draw baseline for visualization
+    Brain.Screen.clearScreen(black);
+    Brain.Screen.setPenColor(green);
+    Brain.Screen.drawLine(0, fabs(target) * draw_amplifier, 600, fabs(target) * draw_amplifier);
+    Brain.Screen.setPenColor(red);
+  }
+
+  void plot(double heading) {
+    Brain.Screen.drawLine(index * 3, fabs(previous_heading) * draw_amplifier, (index + 1) * 3, fabs(heading * draw_amplifier));
+    index++;
+    previous_heading = heading;
+  }
+};
+
+/*
+ * Reduces the drive output so drive plus heading correction fits in max_output,
+ * letting the robot turn harder in sharp corners.
+ */
+void applyOverturn(double& drive_output, double correction_output, double max_output) {
+  double overturn_value = fabs(drive_output) + fabs(correction_output) - max_output;
+  if(overturn_value > 0) {
+    if(drive_output > 0) {
+      drive_output -= overturn_value;
+    } else {
+      drive_output += overturn_value;
+    }
+  }
+}
+
 // ============================================================================
 // MAIN DRIVE AND TURN FUNCTIONS
 // ============================================================================
 
+// Error source: heading toward a fixed target, passed once the heading reaches it from the turn's side.
+struct HeadingError {
+  double target;
+  int turn_direction; // 1 while the heading increases (clockwise), -1 while it decreases
+
+  void measure(ControlState& state) {
+    state.heading = getInertialHeading();
+    state.target_heading = target;
+    state.passed = turn_direction > 0 ? state.heading >= target : state.heading <= target;
+  }
+};
+
+/*
+ * TurnOutput
+ * Output map for point turns: the heading PID output drives the left side forward and the
+ * right side back (turn_direction 1) or the opposite (turn_direction -1).
+ */
+struct TurnOutput {
+  PID& pid;
+  HeadingTrace trace;
+  int turn_direction;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    pid.setTarget(state.target_heading);
+    double output = pid.update(state.heading);
+    trace.plot(state.heading);
+    state.arrived = pid.targetArrived();
+    state.left_output = output;
+    state.right_output = output;
+    chain.minimum(state.left_output, state.right_output);
+  }
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output * turn_direction, -state.right_output * turn_direction);
+  }
+};
+
 /*
  * Turns the robot to a specified angle using PID control.
  * - turn_angle: Target angle to turn to (in degrees).
@@ -151,86 +544,102 @@ void scaleToMax(double& left_output, double& right_output, double max_output) {
  */
 void turnToAngle(double turn_angle, double time_limit_msec, bool exit, double max_output) {
   // Prepare for turn
-  stopChassis(vex::brakeType::coast);
-  is_turning = true;
+  beginMotion();
   double threshold = 1;
   PID pid = PID(turn_kp, turn_ki, turn_kd);
 
   // Normalize and set PID target
   turn_angle = normalizeTarget(turn_angle);
   pid.setTarget(turn_angle);
-  pid.setIntegralMax(0);  
+  pid.setIntegralMax(0);
   pid.setIntegralRange(3);
   pid.setSmallBigErrorTolerance(threshold, threshold * 3);
   pid.setSmallBigErrorDuration(50, 250);
   pid.setDerivativeTolerance(threshold * 4.5);
 
-  // Draw baseline for visualization
-  double draw_amplifier = 230 / fabs(turn_angle);
-  Brain.Screen.clearScreen(black);
-  Brain.Screen.setPenColor(green);
-  Brain.Screen.drawLine(0, fabs(turn_angle) * draw_amplifier, 600, fabs(turn_angle) * draw_amplifier);
-  Brain.Screen.setPenColor(red);
+  // When chaining, turn through the target without stopping at min_output or more
+  bool chained = exit == false && correct_angle != turn_angle;
+  int turn_direction = exit == false && correct_angle > turn_angle ? -1 : 1;
 
-  // PID loop for turning
-  double start_time = Brain.timer(msec);
-  double output;
-  double current_heading = getInertialHeading();
-  double previous_heading = 0;
-  int index = 1;
-  if(exit == false && correct_angle < turn_angle) {
-    // Turn right without stopping at end
-    while (getInertialHeading() < turn_angle && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading); // PID update for heading
-      // Draw heading trace
-      Brain.Screen.drawLine(index * 3, fabs(previous_heading) * draw_amplifier, (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-      // Clamp output
-      if(output < min_output) output = min_output;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-      driveChassis(output, -output);
-      wait(10, msec);
-    }
-  } else if(exit == false && correct_angle > turn_angle) {
-    // Turn left without stopping at end
-    while (getInertialHeading() > turn_angle && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading);
-      Brain.Screen.drawLine(index * 3, fabs(previous_heading) * draw_amplifier, (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-      if(output < min_output) output = min_output;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-      driveChassis(-output, output);
-      wait(10, msec);
+  HeadingError error = { turn_angle, turn_direction };
+  TurnOutput output = { pid, HeadingTrace(turn_angle), turn_direction };
+  SettleOrPassExit exit_policy = { !chained };
+  TurnChain chain = { max_output, chained };
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
+
+  endMotion(exit);
+  correct_angle = turn_angle;
+}
+
+/*
+ * DriveDistanceError
+ * Error source for driveTo: distance traveled from the drive encoders, or with
+ * drive_line_following the along-track distance on the field-frame line through the start
+ * position, with the heading target steering back onto the line.
+ */
+struct DriveDistanceError {
+  double distance_in;
+  int drive_direction;
+  double start_left, start_right, start_slip;
+  double line_x, line_y, line_sin, line_cos;
+  double hold_heading;
+  double current_distance;
+
+  void measure(ControlState& state) {
+    if(drive_line_following) {
+      // Along-track progress and cross-track error (positive right of the line) from odometry
+      double along_track = ((x_pos - line_x) * line_sin + (y_pos - line_y) * line_cos) * drive_direction;
+      double cross_track = (x_pos - line_x) * line_cos - (y_pos - line_y) * line_sin;
+      current_distance = along_track;
+      // Aim at the point on the line line_lookahead_in ahead
+      double steer_deg = radToDeg(controlAtan2(cross_track, line_lookahead_in)) * drive_direction;
+      state.target_heading = normalizeTarget(correct_angle - steer_deg);
+    } else {
+      current_distance = (fabs(((getLeftRotationDegree() - start_left) / 360.0) * wheel_distance_in) + fabs(((getRightRotationDegree() - start_right) / 360.0) * wheel_distance_in)) / 2;
+      // Encoder travel while the wheels slipped is no progress
+      current_distance -= getSlipDistance() - start_slip;
+      state.target_heading = hold_heading;
     }
-  } else {
-    // Standard PID turn
-    while (!pid.targetArrived() && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading);
-      Brain.Screen.drawLine(index * 3, fabs(previous_heading) * draw_amplifier, (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-      driveChassis(output, -output);
-      wait(10, msec);
+    state.heading = getInertialHeading();
+    state.passed = current_distance >= distance_in;
+    updateMarkers(current_distance, distance_in - current_distance, markerPercent(current_distance, distance_in));
+  }
+};
+
+// Output map for driveTo: distance PID on both sides plus heading correction.
+struct DriveOutput {
+  PID& pid_distance;
+  PID& pid_heading;
+  DriveDistanceError& error;
+  bool exit;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    state.left_output = pid_distance.update(error.current_distance) * error.drive_direction;
+    state.right_output = state.left_output;
+    state.arrived = pid_distance.targetArrived();
+    pid_heading.setTarget(state.target_heading);
+    double correction_output = pid_heading.update(state.heading);
+
+    chain.minimum(state.left_output, state.right_output);
+    if(!exit) {
+      state.left_output = 24 * error.drive_direction;
+      state.right_output = 24 * error.drive_direction;
     }
+
+    state.left_output += correction_output;
+    state.right_output -= correction_output;
   }
-  if(exit) {
-    stopChassis(vex::hold);
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
   }
-  correct_angle = turn_angle;
-  is_turning = false;
-}
+};
 
 /*
  * Drives the robot a specified distance (in inches) using PID control.
+ * With drive_line_following enabled, progress and steering come from odometry: the robot
+ * follows the field-frame line through its start position along correct_angle.
  * - distance_in: Target distance to drive (positive or negative).
  * - time_limit_msec: Maximum time allowed for the move (in milliseconds).
  * - exit: If true, stops the robot at the end; if false, allows chaining.
@@ -239,30 +648,9 @@ void turnToAngle(double turn_angle, double time_limit_msec, bool exit, double ma
 void driveTo(double distance_in, double time_limit_msec, bool exit, double max_output) {
   // Store initial encoder values
   double start_left = getLeftRotationDegree(), start_right = getRightRotationDegree();
-  stopChassis(vex::brakeType::coast);
-  is_turning = true;
+  beginMotion();
   double threshold = 0.5;
   int drive_direction = distance_in > 0 ? 1 : -1;
-  double max_slew_fwd = drive_direction > 0 ? max_slew_accel_fwd : max_slew_decel_rev;
-  double max_slew_rev = drive_direction > 0 ? max_slew_decel_fwd : max_slew_accel_rev;
-  bool min_speed = false;
-  if(!exit) {
-    // Adjust slew rates and min speed for chaining
-    if(!dir_change_start && dir_change_end) {
-      max_slew_fwd = drive_direction > 0 ? 24 : max_slew_decel_rev;
-      max_slew_rev = drive_direction > 0 ? max_slew_decel_fwd : 24;
-    }
-    if(dir_change_start && !dir_change_end) {
-      max_slew_fwd = drive_direction > 0 ? max_slew_accel_fwd : 24;
-      max_slew_rev = drive_direction > 0 ? 24 : max_slew_accel_rev;
-      min_speed = true;
-    }
-    if(!dir_change_start && !dir_change_end) {
-      max_slew_fwd = 24;
-      max_slew_rev = 24;
-      min_speed = true;
-    }
-  }
 
   distance_in = distance_in * drive_direction;
   PID pid_distance = PID(distance_kp, distance_ki, distance_kd);
@@ -270,72 +658,85 @@ void driveTo(double distance_in, double time_limit_msec, bool exit, double max_o
 
   // Configure PID controllers
   pid_distance.setTarget(distance_in);
-  pid_distance.setIntegralMax(3);  
+  pid_distance.setIntegralMax(3);
   pid_distance.setSmallBigErrorTolerance(threshold, threshold * 3);
   pid_distance.setSmallBigErrorDuration(50, 250);
   pid_distance.setDerivativeTolerance(5);
 
-  pid_heading.setTarget(normalizeTarget(correct_angle));
-  pid_heading.setIntegralMax(0);  
+  pid_heading.setIntegralMax(0);
   pid_heading.setIntegralRange(1);
   pid_heading.setSmallBigErrorTolerance(0, 0);
   pid_heading.setSmallBigErrorDuration(0, 0);
   pid_heading.setDerivativeTolerance(0);
   pid_heading.setArrive(false);
 
-  double start_time = Brain.timer(msec);
-  double left_output = 0, right_output = 0, correction_output = 0;
-  double current_distance = 0, current_angle = 0;
-
-  // Main PID loop for driving straight
-  while (((!pid_distance.targetArrived()) && Brain.timer(msec) - start_time <= time_limit_msec && exit) || (exit == false && current_distance < distance_in && Brain.timer(msec) - start_time <= time_limit_msec)) {
-    // Calculate current distance and heading
-    current_distance = (fabs(((getLeftRotationDegree() - start_left) / 360.0) * wheel_distance_in) + fabs(((getRightRotationDegree() - start_right) / 360.0) * wheel_distance_in)) / 2;
-    current_angle = getInertialHeading();
-    left_output = pid_distance.update(current_distance) * drive_direction;
-    right_output = left_output;
-    correction_output = pid_heading.update(current_angle);
-
-    // Minimum Output Check
-    if(min_speed) {
-      scaleToMin(left_output, right_output, min_output);
-    }
-    if(!exit) {
-      left_output = 24 * drive_direction;
-      right_output = 24 * drive_direction;
-    }
-
-    left_output += correction_output;
-    right_output -= correction_output;
+  // Field-frame line through the start position along correct_angle
+  DriveDistanceError error = { distance_in, drive_direction, start_left, start_right, getSlipDistance(),
+                               x_pos, y_pos, controlSin(degToRad(correct_angle)), controlCos(degToRad(correct_angle)),
+                               normalizeTarget(correct_angle), 0 };
+  DriveOutput output = { pid_distance, pid_heading, error, exit };
+  SettleOrPassExit exit_policy = { exit };
+  DriveChain chain(drive_direction, exit, max_output);
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
 
-    // Max Output Check
-    scaleToMax(left_output, right_output, max_output);
+  endMotion(exit);
+}
 
-    // Max Acceleration/Deceleration Check
-    if(prev_left_output - left_output > max_slew_rev) {
-      left_output = prev_left_output - max_slew_rev;
-    }
-    if(prev_right_output - right_output > max_slew_rev) {
-      right_output = prev_right_output - max_slew_rev;
-    }
-    if(left_output - prev_left_output > max_slew_fwd) {
-      left_output = prev_left_output + max_slew_fwd;
+// Error source for curveCircle: outer wheel travel and the heading expected at that point of the arc.
+struct ArcEncoderError {
+  int curve_direction;
+  double start_left, start_right;
+  double out_arc, start_heading, result_angle_deg;
+  double current_outer;
+
+  void measure(ControlState& state) {
+    state.heading = getInertialHeading();
+    if(curve_direction == 1) {
+      current_outer = fabs(((getLeftRotationDegree() - start_left) / 360.0) * wheel_distance_in);
+    } else {
+      current_outer = fabs(((getRightRotationDegree() - start_right) / 360.0) * wheel_distance_in);
     }
-    if(right_output - prev_right_output > max_slew_fwd) {
-      right_output = prev_right_output + max_slew_fwd;
+    // Calculate the real angle along the arc
+    double real_angle = current_outer / out_arc * (result_angle_deg - start_heading) + start_heading;
+    state.target_heading = normalizeTarget(real_angle);
+    state.passed = current_outer >= out_arc;
+  }
+};
+
+// Output map for curveCircle: distance PID on the outer side, the inner side scaled by the arc ratio.
+struct ArcEncoderOutput {
+  PID& pid_out;
+  PID& pid_turn;
+  ArcEncoderError& error;
+  int drive_direction;
+  double ratio;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    pid_turn.setTarget(state.target_heading);
+    double outer_output = pid_out.update(error.current_outer) * drive_direction;
+    state.arrived = pid_out.targetArrived();
+    if(error.curve_direction == 1) {
+      state.left_output = outer_output;
+      state.right_output = outer_output * ratio;
+    } else {
+      state.right_output = outer_output;
+      state.left_output = outer_output * ratio;
     }
-    prev_left_output = left_output;
-    prev_right_output = right_output;
-    driveChassis(left_output, right_output);
-    wait(10, msec);
+    double correction_output = pid_turn.update(state.heading);
+
+    // Enforce minimum output if chaining
+    chain.minimum(state.left_output, state.right_output);
+
+    // Apply heading correction
+    state.left_output += correction_output;
+    state.right_output -= correction_output;
   }
-  if(exit) {
-    prev_left_output = 0;
-    prev_right_output = 0;
-    stopChassis(vex::hold);
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
   }
-  is_turning = false;
-}
+};
 
 /*
  * CurveCircle
@@ -350,7 +751,6 @@ void curveCircle(double result_angle_deg, double center_radius, double time_limi
   // Store initial encoder values for both sides
   double start_right = getRightRotationDegree(), start_left = getLeftRotationDegree();
   double in_arc, out_arc;
-  double real_angle = 0, current_angle = 0;
   double ratio, result_angle;
 
   // Normalize the target angle to be within +/-180 degrees of the current heading
@@ -362,8 +762,7 @@ void curveCircle(double result_angle_deg, double center_radius, double time_limi
   out_arc = fabs((fabs(center_radius) + (distance_between_wheels / 2)) * result_angle);
   ratio = in_arc / out_arc;
 
-  stopChassis(vex::brakeType::coast);
-  is_turning = true;
+  beginMotion();
   double threshold = 0.5;
 
   // Determine curve and drive direction
@@ -375,156 +774,73 @@ void curveCircle(double result_angle_deg, double center_radius, double time_limi
     drive_direction = -1;
   }
 
-  // Slew rate and minimum speed logic for chaining
-  double max_slew_fwd = drive_direction > 0 ? max_slew_accel_fwd : max_slew_decel_rev;
-  double max_slew_rev = drive_direction > 0 ? max_slew_decel_fwd : max_slew_accel_rev;
-  bool min_speed = false;
-  if(!exit) {
-    if(!dir_change_start && dir_change_end) {
-      max_slew_fwd = drive_direction > 0 ? 24 : max_slew_decel_rev;
-      max_slew_rev = drive_direction > 0 ? max_slew_decel_fwd : 24;
-    }
-    if(dir_change_start && !dir_change_end) {
-      max_slew_fwd = drive_direction > 0 ? max_slew_accel_fwd : 24;
-      max_slew_rev = drive_direction > 0 ? 24 : max_slew_accel_rev;
-      min_speed = true;
-    }
-    if(!dir_change_start && !dir_change_end) {
-      max_slew_fwd = 24;
-      max_slew_rev = 24;
-      min_speed = true;
-    }
-  }
-
   // Initialize PID controllers for arc distance and heading correction
   PID pid_out = PID(distance_kp, distance_ki, distance_kd);
   PID pid_turn = PID(heading_correction_kp, heading_correction_ki, heading_correction_kd);
 
   pid_out.setTarget(out_arc);
-  pid_out.setIntegralMax(0);  
+  pid_out.setIntegralMax(0);
   pid_out.setIntegralRange(5);
   pid_out.setSmallBigErrorTolerance(0.3, 0.9);
   pid_out.setSmallBigErrorDuration(50, 250);
   pid_out.setDerivativeTolerance(threshold * 4.5);
 
   pid_turn.setTarget(0);
-  pid_turn.setIntegralMax(0);  
+  pid_turn.setIntegralMax(0);
   pid_turn.setIntegralRange(1);
   pid_turn.setSmallBigErrorTolerance(0, 0);
   pid_turn.setSmallBigErrorDuration(0, 0);
   pid_turn.setDerivativeTolerance(0);
   pid_turn.setArrive(false);
 
-  double start_time = Brain.timer(msec);
-  double left_output = 0, right_output = 0, correction_output = 0;
-  double current_right = 0, current_left = 0;
-
-  // Main control loop for each curve/exit configuration
-  if (curve_direction == -1 && exit == true) {
-    // Left curve, stop at end
-    while (!pid_out.targetArrived() && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_angle = getInertialHeading();
-      current_right = fabs(((getRightRotationDegree() - start_right) / 360.0) * wheel_distance_in);
-      // Calculate the real angle along the arc
-      real_angle = current_right/out_arc * (result_angle_deg - correct_angle) + correct_angle;
-      pid_turn.setTarget(normalizeTarget(real_angle));
-      right_output = pid_out.update(current_right) * drive_direction;
-      left_output = right_output * ratio;
-      correction_output = pid_turn.update(current_angle);
-
-      // Enforce minimum output if chaining
-      if(min_speed) {
-        scaleToMin(left_output, right_output, min_output);
-      }
+  ArcEncoderError error = { curve_direction, start_left, start_right, out_arc, correct_angle, result_angle_deg, 0 };
+  ArcEncoderOutput output = { pid_out, pid_turn, error, drive_direction, ratio };
+  SettleOrPassExit exit_policy = { exit };
+  // Minimum speed when chaining, no slew limits
+  DriveChain chain(drive_direction, exit, max_output, false);
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
 
-      // Apply heading correction
-      left_output += correction_output;
-      right_output -= correction_output;
-
-      // Enforce maximum output
-      scaleToMax(left_output, right_output, max_output);
-
-      driveChassis(left_output, right_output);
-      wait(10, msec);
-    }
-  } else if (curve_direction == 1 && exit == true) {
-    // Right curve, stop at end
-    while (!pid_out.targetArrived() && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_angle = getInertialHeading();
-      current_left = fabs(((getLeftRotationDegree() - start_left) / 360.0) * wheel_distance_in);
-      real_angle = current_left/out_arc * (result_angle_deg - correct_angle) + correct_angle;
-      pid_turn.setTarget(normalizeTarget(real_angle));
-      left_output = pid_out.update(current_left) * drive_direction;
-      right_output = left_output * ratio;
-      correction_output = pid_turn.update(current_angle);
-
-      if(min_speed) {
-        scaleToMin(left_output, right_output, min_output);
-      }
-
-      left_output += correction_output;
-      right_output -= correction_output;
-
-      scaleToMax(left_output, right_output, max_output);
-
-      driveChassis(left_output, right_output);
-      wait(10, msec);
-    }
-  } else if (curve_direction == -1 && exit == false) {
-    // Left curve, chaining (do not stop at end)
-    while (current_right < out_arc && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_angle = getInertialHeading();
-      current_right = fabs(((getRightRotationDegree() - start_right) / 360.0) * wheel_distance_in);
-      real_angle = current_right/out_arc * (result_angle_deg - correct_angle) + correct_angle;
-      pid_turn.setTarget(normalizeTarget(real_angle));
-      right_output = pid_out.update(current_right) * drive_direction;
-      left_output = right_output * ratio;
-      correction_output = pid_turn.update(current_angle);
-
-      if(min_speed) {
-        scaleToMin(left_output, right_output, min_output);
-      }
-      
-      left_output += correction_output;
-      right_output -= correction_output;
-
-      scaleToMax(left_output, right_output, max_output);
-
-      driveChassis(left_output, right_output);
-      wait(10, msec);
-    }
-  } else {
-    // Right curve, chaining (do not stop at end)
-    while (current_left < out_arc && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_angle = getInertialHeading();
-      current_left = fabs(((getLeftRotationDegree() - start_left) / 360.0) * wheel_distance_in);
-      real_angle = current_left/out_arc * (result_angle_deg - correct_angle) + correct_angle;
-      pid_turn.setTarget(normalizeTarget(real_angle));
-      left_output = pid_out.update(current_left) * drive_direction;
-      right_output = left_output * ratio;
-      correction_output = pid_turn.update(current_angle);
-
-      if(min_speed) {
-        scaleToMin(left_output, right_output, min_output);
-      }
-
-      left_output += correction_output;
-      right_output -= correction_output;
+  endMotion(exit);
+  // Update the global heading
+  correct_angle = result_angle_deg;
+}
 
-      scaleToMax(left_output, right_output, max_output);
+/*
+ * SwingOutput
+ * Output map for swings: the heading PID output spins one side while the other holds.
+ * - choice 1: swing left forward, 2: right forward, 3: left backward, 4: right backward.
+ */
+struct SwingOutput {
+  PID& pid;
+  HeadingTrace trace;
+  int choice;
+  double drive_direction;
+  bool chained;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    pid.setTarget(state.target_heading);
+    double output = pid.update(state.heading);
+    trace.plot(state.heading);
+    state.arrived = pid.targetArrived();
+    state.left_output = output;
+    state.right_output = output;
+    chain.minimum(state.left_output, state.right_output);
+  }
 
-      driveChassis(left_output, right_output);
-      wait(10, msec);
+  void apply(const ControlState& state) {
+    // Settling swings that turn left reverse the PID output
+    double sign = !chained && (choice == 1 || choice == 3) ? -1 : 1;
+    double output = compensateVoltage(sign * state.left_output * drive_direction);
+    if(choice == 2 || choice == 3) {
+      left_chassis.spin(fwd, output, volt);
+      right_chassis.stop(hold); // Hold right, swing left
+    } else {
+      left_chassis.stop(hold); // Hold left, swing right
+      right_chassis.spin(fwd, output, volt);
     }
   }
-  // Stop the chassis if required
-  if(exit == true) {
-    stopChassis(vex::brakeType::hold);
-  }
-  // Update the global heading
-  correct_angle = result_angle_deg;
-  is_turning = false;
-}
+};
 
 /*
  * Swing
@@ -536,36 +852,21 @@ void curveCircle(double result_angle_deg, double center_radius, double time_limi
  * - max_output: Maximum voltage output to motors.
  */
 void swing(double swing_angle, double drive_direction, double time_limit_msec, bool exit, double max_output) {
-  stopChassis(vex::brakeType::coast); // Stop chassis before starting swing
-  is_turning = true;                  // Set turning state
+  beginMotion();
   double threshold = 1;
   PID pid = PID(turn_kp, turn_ki, turn_kd); // Initialize PID for turning
 
   swing_angle = normalizeTarget(swing_angle); // Normalize target angle
   pid.setTarget(swing_angle);                 // Set PID target
-  pid.setIntegralMax(0);  
+  pid.setIntegralMax(0);
   pid.setIntegralRange(5);
 
   pid.setSmallBigErrorTolerance(threshold, threshold * 3);
   pid.setSmallBigErrorDuration(50, 250);
   pid.setDerivativeTolerance(threshold * 4.5);
 
-  // Draw the baseline for visualization
-  double draw_amplifier = 230 / fabs(swing_angle);
-  Brain.Screen.clearScreen(black);
-  Brain.Screen.setPenColor(green);
-  Brain.Screen.drawLine(0, fabs(swing_angle) * draw_amplifier, 600, fabs(swing_angle) * draw_amplifier);
-  Brain.Screen.setPenColor(red);
-
-  // Start the PID loop
-  double start_time = Brain.timer(msec);
-  double output;
-  double current_heading = correct_angle;
-  double previous_heading = 0;
-  int index = 1;
-  int choice = 1;
-
   // Determine which side to swing and direction
+  int choice = 1;
   if(swing_angle - correct_angle < 0 && drive_direction == 1) {
     choice = 1;
   } else if(swing_angle - correct_angle > 0 && drive_direction == 1) {
@@ -576,139 +877,16 @@ void swing(double swing_angle, double drive_direction, double time_limit_msec, b
     choice = 4;
   }
 
-  // Swing logic for each case, chaining (exit == false)
-  if(choice == 1 && exit == false) {
-    // Swing left, forward
-    while (current_heading > swing_angle && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading);
-
-      // Draw heading trace
-      Brain.Screen.drawLine(
-          index * 3, fabs(previous_heading) * draw_amplifier, 
-          (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-
-      // Clamp output
-      if(output < min_output) output = min_output;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-
-      left_chassis.stop(hold); // Hold left, swing right
-      right_chassis.spin(fwd, output * drive_direction, volt);
-      wait(10, msec);
-    }
-  } else if(choice == 2 && exit == false) {
-    // Swing right, forward
-    while (current_heading < swing_angle && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading);
-
-      // Draw heading trace
-      Brain.Screen.drawLine(
-          index * 3, fabs(previous_heading) * draw_amplifier, 
-          (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-
-      // Clamp output
-      if(output < min_output) output = min_output;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-
-      left_chassis.spin(fwd, output * drive_direction, volt);
-      right_chassis.stop(hold); // Hold right, swing left
-      wait(10, msec);
-    }
-  } else if(choice == 3 && exit == false) {
-    // Swing left, backward
-    while (current_heading > swing_angle && Brain.timer(msec) - start_time <= time_limit_msec) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading);
-
-      // Draw heading trace
-      Brain.Screen.drawLine(
-          index * 3, fabs(previous_heading) * draw_amplifier, 
-          (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-
-      // Clamp output
-      if(output < min_output) output = min_output;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-
-      left_chassis.spin(fwd, output * drive_direction, volt);
-      right_chassis.stop(hold);
-      wait(10, msec);
-    }
-  } else {
-    // Swing right, backward
-    while (current_heading < swing_angle && Brain.timer(msec) - start_time <= time_limit_msec && exit == false) {
-      current_heading = getInertialHeading();
-      output = pid.update(current_heading);
-
-      // Draw heading trace
-      Brain.Screen.drawLine(
-          index * 3, fabs(previous_heading) * draw_amplifier, 
-          (index + 1) * 3, fabs(current_heading * draw_amplifier));
-      index++;
-      previous_heading = current_heading;
-
-      // Clamp output
-      if(output < min_output) output = min_output;
-      if(output > max_output) output = max_output;
-      else if(output < -max_output) output = -max_output;
-
-      left_chassis.stop(hold);
-      right_chassis.spin(fwd, output * drive_direction, volt);
-      wait(10, msec);
-    }
-  }
-
-  // PID loop for exit == true (stop at end)
-  while (!pid.targetArrived() && Brain.timer(msec) - start_time <= time_limit_msec && exit == true) {
-    current_heading = getInertialHeading();
-    output = pid.update(current_heading);
+  // When chaining, swing through the target at min_output or more
+  bool chained = exit == false;
+  HeadingError error = { swing_angle, choice == 2 || choice == 4 ? 1 : -1 };
+  SwingOutput output = { pid, HeadingTrace(swing_angle), choice, drive_direction, chained };
+  SettleOrPassExit exit_policy = { !chained };
+  TurnChain chain = { max_output, chained };
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
 
-    // Draw heading trace
-    Brain.Screen.drawLine(
-        index * 3, fabs(previous_heading) * draw_amplifier, 
-        (index + 1) * 3, fabs(current_heading * draw_amplifier));
-    index++;
-    previous_heading = current_heading;
-
-    // Clamp output
-    if(output > max_output) output = max_output;
-    else if(output < -max_output) output = -max_output;
-
-    // Apply output to correct side based on swing direction
-    switch(choice) {
-    case 1:
-      left_chassis.stop(hold);
-      right_chassis.spin(fwd, -output * drive_direction, volt);
-      break;
-    case 2:
-      left_chassis.spin(fwd, output * drive_direction, volt);
-      right_chassis.stop(hold);
-      break;
-    case 3:
-      left_chassis.spin(fwd, -output * drive_direction, volt);
-      right_chassis.stop(hold);
-      break;
-    case 4:
-      left_chassis.stop(hold);
-      right_chassis.spin(fwd, output * drive_direction, volt);
-      break;
-    }
-    wait(10, msec);
-  }
-  if(exit == true) {
-    stopChassis(vex::hold); // Stop chassis at end if required
-  }
+  endMotion(exit);
   correct_angle = swing_angle; // Update global heading
-  is_turning = false;          // Reset turning state
 }
 
 /*
@@ -739,6 +917,99 @@ void correctHeading() {
   }
 }
 
+/*
+ * integratePose
+ * Adds one odometry step to x_pos/y_pos with the SE(2) exponential map, which is exact
+ * when the tracking center moves along a constant-curvature arc during the step.
+ * - forward_in: Arc length traveled forward by the tracking center (in inches).
+ * - right_in: Arc length traveled sideways (to the right) by the tracking center (in inches).
+ * - delta_heading_rad: Heading change during the step (in radians, clockwise positive).
+ * - prev_heading_rad: Heading at the start of the step (in radians).
+ */
+template <typename Scalar>
+void integratePose(Scalar forward_in, Scalar right_in, Scalar delta_heading_rad, double prev_heading_rad) {
+  // Moving along the arc equals moving along its chord at the mid-step heading;
+  // the chord is the arc length scaled by sin(h/2) / (h/2)
+  Scalar half_rad = delta_heading_rad / 2;
+  Scalar chord_scale = fabs(half_rad) < 1e-3 ? 1 - half_rad * half_rad / 6 : controlSin(half_rad) / half_rad;
+  // The absolute heading stays double: in float it loses precision as the robot keeps turning
+  double mid_heading_rad = prev_heading_rad + half_rad;
+  Scalar sin_mid = controlSin(mid_heading_rad), cos_mid = controlCos(mid_heading_rad);
+
+  x_pos += chord_scale * (forward_in * sin_mid + right_in * cos_mid);
+  y_pos += chord_scale * (forward_in * cos_mid - right_in * sin_mid);
+}
+
+/*
+ * trackerArc
+ * Arc length of the tracking center along a wheel's axis during one step.
+ * - delta_in: Travel measured by the wheel (in inches).
+ * - delta_heading_rad: Heading change during the step (in radians).
+ * - offset_in: Distance from the tracking center to the wheel (in inches).
+ */
+template <typename Scalar>
+Scalar trackerArc(Scalar delta_in, Scalar delta_heading_rad, Scalar offset_in) {
+  return delta_in + offset_in * delta_heading_rad;
+}
+
+/*
+ * waitOdomStep
+ * Sleeps until the next odometry sample; odom_substeps samples are taken every 10 msec.
+ * The pose is recorded in the pose history once per 10 msec, on every odom_substeps-th
+ * sample, so the history covers the same time at any sub-step count.
+ */
+void waitOdomStep() {
+  if (++odometry_steps_unrecorded >= odom_substeps) {
+    recordPose(Brain.timer(msec), x_pos, y_pos, getInertialHeading());
+    odometry_steps_unrecorded = 0;
+  }
+  wait(10.0 / fmax(odom_substeps, 1), msec);
+}
+
+/*
+ * Current heading, drive encoder and tracking wheel readings.
+ */
+OdometryReadings readOdometry() {
+  OdometryReadings readings = { degToRad(getInertialHeading()), getLeftRotationDegree(), getRightRotationDegree(),
+                                vertical_tracker.position(degrees), right_vertical_tracker.position(degrees), horizontal_tracker.position(degrees) };
+  return readings;
+}
+
+void resetOdometryHeading(double heading_deg) {
+  setCorrectedHeading(heading_deg);
+  correct_angle = heading_deg;
+  odometry_reset_readings = readOdometry();
+  odometry_resets++;
+}
+
+/*
+ * Whether the tracker has to take its previous readings from somewhere else before this step:
+ * the current readings on its first step, the readings at the reset after resetOdometryHeading.
+ * Measuring from there keeps the heading jump from counting as a turn and the travel since the reset.
+ * - resets_seen: Resets the tracker has handled, -1 before its first step; updated.
+ * - from: Set to the readings to measure from.
+ */
+bool odometryReset(int& resets_seen, OdometryReadings& from) {
+  if (resets_seen == odometry_resets) {
+    return false;
+  }
+  from = resets_seen < 0 ? readOdometry() : odometry_reset_readings;
+  resets_seen = odometry_resets;
+  return true;
+}
+
+/*
+ * Forward travel of the tracking center measured by the drive encoders since the last step.
+ * - prev_left_deg, prev_right_deg: Encoder readings at the last step, updated to the current ones.
+ */
+double encoderForward(double& prev_left_deg, double& prev_right_deg) {
+  double left_deg = getLeftRotationDegree(), right_deg = getRightRotationDegree();
+  double forward_in = ((left_deg - prev_left_deg) + (right_deg - prev_right_deg)) / 2 * wheel_distance_in / 360.0;
+  prev_left_deg = left_deg;
+  prev_right_deg = right_deg;
+  return forward_in;
+}
+
 /*
  * trackNoOdomWheel
  * Tracks the robot's position using only drivetrain encoders and inertial sensor.
@@ -748,37 +1019,27 @@ void trackNoOdomWheel() {
   resetChassis();
   double prev_heading_rad = 0;
   double prev_left_deg = 0, prev_right_deg = 0;
-  double delta_local_y_in = 0;
+  double step_sec = 0.01 / fmax(odom_substeps, 1);
+  int resets_seen = -1;
+  OdometryReadings from;
 
   while (true) {
     double heading_rad = degToRad(getInertialHeading());
-    double left_deg = getLeftRotationDegree();
-    double right_deg = getRightRotationDegree();
-    double delta_heading_rad = heading_rad - prev_heading_rad; // Change in heading (radians)
-    double delta_left_in = (left_deg - prev_left_deg) * wheel_distance_in / 360.0;   // Left wheel delta (inches)
-    double delta_right_in = (right_deg - prev_right_deg) * wheel_distance_in / 360.0; // Right wheel delta (inches)
-    // If no heading change, treat as straight movement
-    if (fabs(delta_heading_rad) < 1e-6) {
-      delta_local_y_in = (delta_left_in + delta_right_in) / 2.0;
-    } else {
-      // Calculate arc movement for each wheel
-      double sin_multiplier = 2.0 * sin(delta_heading_rad / 2.0);
-      double delta_local_y_left_in = sin_multiplier * (delta_left_in / delta_heading_rad + distance_between_wheels / 2.0);
-      double delta_local_y_right_in = sin_multiplier * (delta_right_in / delta_heading_rad + distance_between_wheels / 2.0);
-      delta_local_y_in = (delta_local_y_left_in + delta_local_y_right_in) / 2.0;
+    if (odometryReset(resets_seen, from)) {
+      prev_heading_rad = from.heading_rad;
+      prev_left_deg = from.left_deg;
+      prev_right_deg = from.right_deg;
     }
-    // Update global position using polar coordinates
-    double polar_angle_rad = prev_heading_rad + delta_heading_rad / 2.0;
-    double polar_radius_in = delta_local_y_in;
+    control_scalar delta_heading_rad = heading_rad - prev_heading_rad; // Change in heading (radians)
 
-    x_pos += polar_radius_in * sin(polar_angle_rad);
-    y_pos += polar_radius_in * cos(polar_angle_rad);
+    // The sides sit symmetrically around the center, so their rotation terms cancel;
+    // encoder travel while the wheels slip is not counted
+    control_scalar forward_in = slipForward(encoderForward(prev_left_deg, prev_right_deg), 0, false, step_sec);
+    integratePose(forward_in, (control_scalar)0, delta_heading_rad, prev_heading_rad);
 
     prev_heading_rad = heading_rad;
-    prev_left_deg = left_deg;
-    prev_right_deg = right_deg;
 
-    wait(10, msec);
+    waitOdomStep();
   }
 }
 
@@ -790,44 +1051,37 @@ void trackXYOdomWheel() {
   resetChassis();
   double prev_heading_rad = 0;
   double prev_horizontal_pos_deg = 0, prev_vertical_pos_deg = 0;
-  double delta_local_x_in = 0, delta_local_y_in = 0;
-  double local_polar_angle_rad = 0;
+  double prev_left_deg = 0, prev_right_deg = 0;
+  double step_sec = 0.01 / fmax(odom_substeps, 1);
+  int resets_seen = -1;
+  OdometryReadings from;
 
   while (true) {
     double heading_rad = degToRad(getInertialHeading());
     double horizontal_pos_deg = horizontal_tracker.position(degrees);
     double vertical_pos_deg = vertical_tracker.position(degrees);
-    double delta_heading_rad = heading_rad - prev_heading_rad;
-    double delta_horizontal_in = (horizontal_pos_deg - prev_horizontal_pos_deg) * horizontal_tracker_diameter * M_PI / 360.0; // horizontal tracker delta (inches)
-    double delta_vertical_in = (vertical_pos_deg - prev_vertical_pos_deg) * vertical_tracker_diameter * M_PI / 360.0; // vertical tracker delta (inches)
-
-    // Calculate local movement based on heading change
-    if (fabs(delta_heading_rad) < 1e-6) {
-      delta_local_x_in = delta_horizontal_in;
-      delta_local_y_in = delta_vertical_in;
-    } else {
-      double sin_multiplier = 2.0 * sin(delta_heading_rad / 2.0);
-      delta_local_x_in = sin_multiplier * ((delta_horizontal_in / delta_heading_rad) + horizontal_tracker_dist_from_center);
-      delta_local_y_in = sin_multiplier * ((delta_vertical_in / delta_heading_rad) + vertical_tracker_dist_from_center);
-    }
-
-    // Avoid undefined atan2(0, 0)
-    if (fabs(delta_local_x_in) < 1e-6 && fabs(delta_local_y_in) < 1e-6) {
-      local_polar_angle_rad = 0;
-    } else {
-      local_polar_angle_rad = atan2(delta_local_y_in, delta_local_x_in);
+    if (odometryReset(resets_seen, from)) {
+      prev_heading_rad = from.heading_rad;
+      prev_horizontal_pos_deg = from.horizontal_deg;
+      prev_vertical_pos_deg = from.vertical_deg;
+      prev_left_deg = from.left_deg;
+      prev_right_deg = from.right_deg;
     }
-    double polar_radius_in = sqrt(pow(delta_local_x_in, 2) + pow(delta_local_y_in, 2));
-    double polar_angle_rad = local_polar_angle_rad - heading_rad - (delta_heading_rad / 2);
+    control_scalar delta_heading_rad = heading_rad - prev_heading_rad;
+    control_scalar delta_horizontal_in = (horizontal_pos_deg - prev_horizontal_pos_deg) * horizontal_tracker_diameter * M_PI / 360.0; // horizontal tracker delta (inches)
+    control_scalar delta_vertical_in = (vertical_pos_deg - prev_vertical_pos_deg) * vertical_tracker_diameter * M_PI / 360.0; // vertical tracker delta (inches)
 
-    x_pos += polar_radius_in * cos(polar_angle_rad);
-    y_pos += polar_radius_in * sin(polar_angle_rad);
+    // Calculate local movement based on heading change
+    control_scalar right_in = trackerArc(delta_horizontal_in, delta_heading_rad, (control_scalar)horizontal_tracker_dist_from_center);
+    control_scalar forward_in = trackerArc(delta_vertical_in, delta_heading_rad, (control_scalar)vertical_tracker_dist_from_center);
+    slipForward(encoderForward(prev_left_deg, prev_right_deg), forward_in, true, step_sec); // Slip detection only
+    integratePose(forward_in, right_in, delta_heading_rad, prev_heading_rad);
 
     prev_heading_rad = heading_rad;
     prev_horizontal_pos_deg = horizontal_pos_deg;
     prev_vertical_pos_deg = vertical_pos_deg;
 
-    wait(10, msec);
+    waitOdomStep();
   }
 }
 
@@ -840,48 +1094,31 @@ void trackXOdomWheel() {
   double prev_heading_rad = 0;
   double prev_horizontal_pos_deg = 0;
   double prev_left_deg = 0, prev_right_deg = 0;
-  double delta_local_x_in = 0, delta_local_y_in = 0;
-  double local_polar_angle_rad = 0;
+  double step_sec = 0.01 / fmax(odom_substeps, 1);
+  int resets_seen = -1;
+  OdometryReadings from;
 
   while (true) {
     double heading_rad = degToRad(getInertialHeading());
     double horizontal_pos_deg = horizontal_tracker.position(degrees);
-    double left_deg = getLeftRotationDegree();
-    double right_deg = getRightRotationDegree();
-    double delta_heading_rad = heading_rad - prev_heading_rad;
-    double delta_horizontal_in = (horizontal_pos_deg - prev_horizontal_pos_deg) * horizontal_tracker_diameter * M_PI / 360.0; // horizontal tracker delta (inches)
-    double delta_left_in = (left_deg - prev_left_deg) * wheel_distance_in / 360.0;   // Left wheel delta (inches)
-    double delta_right_in = (right_deg - prev_right_deg) * wheel_distance_in / 360.0; // Right wheel delta (inches)
-
-    // Calculate local movement based on heading change
-    if (fabs(delta_heading_rad) < 1e-6) {
-      delta_local_x_in = delta_horizontal_in;
-      delta_local_y_in = (delta_left_in + delta_right_in) / 2.0;
-    } else {
-      double sin_multiplier = 2.0 * sin(delta_heading_rad / 2.0);
-      delta_local_x_in = sin_multiplier * ((delta_horizontal_in / delta_heading_rad) + horizontal_tracker_dist_from_center);
-      double delta_local_y_left_in = sin_multiplier * (delta_left_in / delta_heading_rad + distance_between_wheels / 2.0);
-      double delta_local_y_right_in = sin_multiplier * (delta_right_in / delta_heading_rad + distance_between_wheels / 2.0);
-      delta_local_y_in = (delta_local_y_left_in + delta_local_y_right_in) / 2.0;
+    if (odometryReset(resets_seen, from)) {
+      prev_heading_rad = from.heading_rad;
+      prev_horizontal_pos_deg = from.horizontal_deg;
+      prev_left_deg = from.left_deg;
+      prev_right_deg = from.right_deg;
     }
+    control_scalar delta_heading_rad = heading_rad - prev_heading_rad;
+    control_scalar delta_horizontal_in = (horizontal_pos_deg - prev_horizontal_pos_deg) * horizontal_tracker_diameter * M_PI / 360.0; // horizontal tracker delta (inches)
 
-    if (fabs(delta_local_x_in) < 1e-6 && fabs(delta_local_y_in) < 1e-6) {
-      local_polar_angle_rad = 0;
-    } else {
-      local_polar_angle_rad = atan2(delta_local_y_in, delta_local_x_in);
-    }
-    double polar_radius_in = sqrt(pow(delta_local_x_in, 2) + pow(delta_local_y_in, 2));
-    double polar_angle_rad = local_polar_angle_rad - heading_rad - (delta_heading_rad / 2);
+    // Calculate local movement based on heading change, forward from the drive encoders unless they slip
+    control_scalar right_in = trackerArc(delta_horizontal_in, delta_heading_rad, (control_scalar)horizontal_tracker_dist_from_center);
+    control_scalar forward_in = slipForward(encoderForward(prev_left_deg, prev_right_deg), 0, false, step_sec);
+    integratePose(forward_in, right_in, delta_heading_rad, prev_heading_rad);
 
-    x_pos += polar_radius_in * cos(polar_angle_rad);
-    y_pos += polar_radius_in * sin(polar_angle_rad);
-    
     prev_heading_rad = heading_rad;
     prev_horizontal_pos_deg = horizontal_pos_deg;
-    prev_left_deg = left_deg;
-    prev_right_deg = right_deg;
 
-    wait(10, msec);
+    waitOdomStep();
   }
 }
 
@@ -893,35 +1130,101 @@ void trackYOdomWheel() {
   resetChassis();
   double prev_heading_rad = 0;
   double prev_vertical_pos_deg = 0;
-  double delta_local_y_in = 0;
+  double prev_left_deg = 0, prev_right_deg = 0;
+  double step_sec = 0.01 / fmax(odom_substeps, 1);
+  int resets_seen = -1;
+  OdometryReadings from;
 
   while (true) {
     double heading_rad = degToRad(getInertialHeading());
     double vertical_pos_deg = vertical_tracker.position(degrees);
-    double delta_heading_rad = heading_rad - prev_heading_rad;
-    double delta_vertical_in = (vertical_pos_deg - prev_vertical_pos_deg) * vertical_tracker_diameter * M_PI / 360.0; // vertical tracker delta (inches)
+    if (odometryReset(resets_seen, from)) {
+      prev_heading_rad = from.heading_rad;
+      prev_vertical_pos_deg = from.vertical_deg;
+      prev_left_deg = from.left_deg;
+      prev_right_deg = from.right_deg;
+    }
+    control_scalar delta_heading_rad = heading_rad - prev_heading_rad;
+    control_scalar delta_vertical_in = (vertical_pos_deg - prev_vertical_pos_deg) * vertical_tracker_diameter * M_PI / 360.0; // vertical tracker delta (inches)
 
     // Calculate local movement based on heading change
-    if (fabs(delta_heading_rad) < 1e-6) {
-      delta_local_y_in = delta_vertical_in;
-    } else {
-      double sin_multiplier = 2.0 * sin(delta_heading_rad / 2.0);
-      delta_local_y_in = sin_multiplier * ((delta_vertical_in / delta_heading_rad) + vertical_tracker_dist_from_center);
+    control_scalar forward_in = trackerArc(delta_vertical_in, delta_heading_rad, (control_scalar)vertical_tracker_dist_from_center);
+    slipForward(encoderForward(prev_left_deg, prev_right_deg), forward_in, true, step_sec); // Slip detection only
+    integratePose(forward_in, (control_scalar)0, delta_heading_rad, prev_heading_rad);
+
+    prev_heading_rad = heading_rad;
+    prev_vertical_pos_deg = vertical_pos_deg;
+
+    waitOdomStep();
+  }
+}
+
+/*
+ * trackParallelOdomWheel
+ * Tracks position using two parallel vertical odometry wheels (vertical_tracker on the left,
+ * right_vertical_tracker on the right) and, if installed, the horizontal wheel.
+ * Heading change comes from the difference of the two wheels and is complementary
+ * filtered against the inertial heading to remove long-term drift.
+ */
+void trackParallelOdomWheel() {
+  resetChassis();
+  double heading_rad = 0;
+  double prev_left_pos_deg = 0, prev_right_pos_deg = 0, prev_horizontal_pos_deg = 0;
+  control_scalar left_offset_in = vertical_tracker_dist_from_center;
+  control_scalar tracker_width_in = right_vertical_tracker_dist_from_center - vertical_tracker_dist_from_center;
+  double prev_left_deg = 0, prev_right_deg = 0;
+  double step_sec = 0.01 / fmax(odom_substeps, 1);
+  int resets_seen = -1;
+  OdometryReadings from;
+
+  while (true) {
+    double left_pos_deg = vertical_tracker.position(degrees);
+    double right_pos_deg = right_vertical_tracker.position(degrees);
+    double horizontal_pos_deg = using_horizontal_tracker ? horizontal_tracker.position(degrees) : prev_horizontal_pos_deg;
+    if (odometryReset(resets_seen, from)) {
+      // The wheel heading restarts from the reset heading instead of drifting toward it
+      heading_rad = from.heading_rad;
+      prev_left_pos_deg = from.vertical_deg;
+      prev_right_pos_deg = from.right_vertical_deg;
+      prev_horizontal_pos_deg = using_horizontal_tracker ? from.horizontal_deg : 0;
+      prev_left_deg = from.left_deg;
+      prev_right_deg = from.right_deg;
     }
+    control_scalar delta_left_in = (left_pos_deg - prev_left_pos_deg) * vertical_tracker_diameter * M_PI / 360.0;
+    control_scalar delta_right_in = (right_pos_deg - prev_right_pos_deg) * right_vertical_tracker_diameter * M_PI / 360.0;
+    control_scalar delta_horizontal_in = (horizontal_pos_deg - prev_horizontal_pos_deg) * horizontal_tracker_diameter * M_PI / 360.0;
 
-    double polar_angle_rad = prev_heading_rad + delta_heading_rad / 2.0;
-    double polar_radius_in = delta_local_y_in;
+    // Clockwise rotation moves the left wheel forward and the right wheel back
+    control_scalar delta_heading_rad = (delta_left_in - delta_right_in) / tracker_width_in;
 
-    x_pos += polar_radius_in * cos(polar_angle_rad);
-    y_pos += polar_radius_in * sin(polar_angle_rad);
+    // Calculate local movement based on the wheel-derived heading change
+    control_scalar right_in = trackerArc(delta_horizontal_in, delta_heading_rad, (control_scalar)horizontal_tracker_dist_from_center);
+    control_scalar forward_in = trackerArc(delta_left_in, delta_heading_rad, left_offset_in);
+    slipForward(encoderForward(prev_left_deg, prev_right_deg), forward_in, true, step_sec); // Slip detection only
+    integratePose(forward_in, right_in, delta_heading_rad, heading_rad);
 
-    prev_heading_rad = heading_rad;
-    prev_vertical_pos_deg = vertical_pos_deg;
+    // Wheels for the short term, inertial sensor for the long term
+    heading_rad = tracker_heading_weight * (heading_rad + delta_heading_rad) +
+                  (1 - tracker_heading_weight) * degToRad(getInertialHeading());
 
-    wait(10, msec);
+    prev_left_pos_deg = left_pos_deg;
+    prev_right_pos_deg = right_pos_deg;
+    prev_horizontal_pos_deg = horizontal_pos_deg;
+
+    waitOdomStep();
   }
 }
 
+// Error source for turnToPoint: heading toward a field point, updated as the robot moves.
+struct PointHeadingError {
+  double x, y, add;
+
+  void measure(ControlState& state) {
+    state.target_heading = normalizeTarget(radToDeg(controlAtan2(x - x_pos, y - y_pos))) + add;
+    state.heading = getInertialHeading();
+  }
+};
+
 /*
  * turnToPoint
  * Turns the robot to face a specific point in the field.
@@ -930,59 +1233,106 @@ void trackYOdomWheel() {
  * - time_limit_msec: Maximum time allowed for the turn (in milliseconds).
  */
 void turnToPoint(double x, double y, int direction, double time_limit_msec) {
-  stopChassis(vex::brakeType::coast); // Stop chassis before turning
-  is_turning = true;                  // Set turning state
+  beginMotion();
   double threshold = 1, add = 0;
   if(direction == -1) {
     add = 180; // Add 180 degrees if turning to face backward
   }
   // Calculate target angle using atan2 and normalize
-  double turn_angle = normalizeTarget(radToDeg(atan2(x - x_pos, y - y_pos))) + add;
+  double turn_angle = normalizeTarget(radToDeg(controlAtan2(x - x_pos, y - y_pos))) + add;
   PID pid = PID(turn_kp, turn_ki, turn_kd);
 
   pid.setTarget(turn_angle); // Set PID target
-  pid.setIntegralMax(0);  
+  pid.setIntegralMax(0);
   pid.setIntegralRange(3);
 
   pid.setSmallBigErrorTolerance(threshold, threshold * 3);
   pid.setSmallBigErrorDuration(100, 500);
   pid.setDerivativeTolerance(threshold * 4.5);
 
-  // Draw the baseline for visualization
-  double draw_amplifier = 230 / fabs(turn_angle);
-  Brain.Screen.clearScreen(black);
-  Brain.Screen.setPenColor(green);
-  Brain.Screen.drawLine(0, fabs(turn_angle) * draw_amplifier, 
-                        600, fabs(turn_angle) * draw_amplifier);
-  Brain.Screen.setPenColor(red);
-
-  // Start the PID loop
-  double start_time = Brain.timer(msec);
-  double output;
-  double current_heading;
-  double previous_heading = 0;
-  int index = 1;
-  while (!pid.targetArrived() && Brain.timer(msec) - start_time <= time_limit_msec) {
-    // Continuously update target as robot moves
-    pid.setTarget(normalizeTarget(radToDeg(atan2(x - x_pos, y - y_pos))) + add);
-    current_heading = getInertialHeading();
-    output = pid.update(current_heading);
-
-    // Draw heading trace
-    Brain.Screen.drawLine(
-        index * 3, fabs(previous_heading) * draw_amplifier, 
-        (index + 1) * 3, fabs(current_heading * draw_amplifier));
-    index++;
-    previous_heading = current_heading;
+  PointHeadingError error = { x, y, add };
+  TurnOutput output = { pid, HeadingTrace(turn_angle), 1 };
+  SettleExit exit_policy;
+  TurnChain chain = { 12, false };
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
 
-    driveChassis(output, -output); // Apply output to chassis
-    wait(10, msec);
-  }  
-  stopChassis(vex::hold); // Stop at end
+  endMotion(true); // Stop at end
   correct_angle = getInertialHeading(); // Update global heading
-  is_turning = false;                   // Reset turning state
 }
 
+/*
+ * PointError
+ * Error source for moveToPoint: heading toward the target point, and the exit line through the
+ * target perpendicular to the robot's heading. The motion ends when the robot crosses it.
+ */
+struct PointError {
+  double x, y;
+  int add;
+  double exit_tolerance;
+  bool prev_perpendicular_line;
+  // Progress tracking for motion markers
+  double start_distance, traveled, prev_x, prev_y;
+
+  void measure(ControlState& state) {
+    state.target_heading = normalizeTarget(radToDeg(controlAtan2(x - x_pos, y - y_pos)) + add);
+    state.heading = getInertialHeading();
+    // Check if robot has crossed the perpendicular line to the target
+    bool perpendicular_line = ((y_pos - y) * -controlCos(degToRad(normalizeTarget(state.heading + add))) <= (x_pos - x) * controlSin(degToRad(normalizeTarget(state.heading + add))) + exit_tolerance);
+    state.crossed = perpendicular_line && !prev_perpendicular_line;
+    prev_perpendicular_line = perpendicular_line;
+    if(state.crossed) {
+      return;
+    }
+
+    traveled += controlHypot(x_pos - prev_x, y_pos - prev_y);
+    prev_x = x_pos;
+    prev_y = y_pos;
+    updateMarkers(traveled, controlHypot(x - x_pos, y - y_pos), markerPercent(start_distance - controlHypot(x - x_pos, y - y_pos), start_distance));
+  }
+};
+
+// Output map for moveToPoint: distance output scaled by the heading error, plus heading correction until 8 inches out.
+struct PointOutput {
+  PID& pid_distance;
+  PID& pid_heading;
+  PointError& error;
+  int dir;
+  bool overturn;
+  double max_output;
+  bool ch;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    // Continuously update targets as robot moves
+    double x = error.x, y = error.y;
+    pid_heading.setTarget(state.target_heading);
+    pid_distance.setTarget(controlHypot(x - x_pos, y - y_pos));
+    // Calculate drive output based on heading and distance
+    state.left_output = pid_distance.update(0) * controlCos(degToRad(controlAtan2(x - x_pos, y - y_pos) * 180 / M_PI + error.add - state.heading)) * dir;
+    state.right_output = state.left_output;
+
+    // Only apply heading correction if far from target
+    double correction_output = 0;
+    if(controlHypot(x - x_pos, y - y_pos) > 8 && ch == true) {
+      correction_output = pid_heading.update(state.heading);
+    } else {
+      ch = false;
+    }
+
+    chain.minimum(state.left_output, state.right_output);
+    double drive_output = state.left_output;
+    if(overturn) {
+      applyOverturn(drive_output, correction_output, max_output);
+    }
+    state.left_output = drive_output + correction_output;
+    state.right_output = drive_output - correction_output;
+  }
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
+  }
+};
+
 /*
  * moveToPoint
  * Moves the robot to a specific point in the field, adjusting heading as needed.
@@ -994,132 +1344,128 @@ void turnToPoint(double x, double y, int direction, double time_limit_msec) {
  * - overturn: If true, allows overturning for sharp turns.
  */
 void moveToPoint(double x, double y, int dir, double time_limit_msec, bool exit, double max_output, bool overturn) {
-  stopChassis(vex::brakeType::coast); // Stop chassis before moving
-  is_turning = true;                  // Set turning state
+  beginMotion();
   double threshold = 0.5;
   int add = dir > 0 ? 0 : 180;
-  double max_slew_fwd = dir > 0 ? max_slew_accel_fwd : max_slew_decel_rev;
-  double max_slew_rev = dir > 0 ? max_slew_decel_fwd : max_slew_accel_rev;
-  bool min_speed = false;
-  if(!exit) {
-    // Adjust slew rates and min speed for chaining
-    if(!dir_change_start && dir_change_end) {
-      max_slew_fwd = dir > 0 ? 24 : max_slew_decel_rev;
-      max_slew_rev = dir > 0 ? max_slew_decel_fwd : 24;
-    }
-    if(dir_change_start && !dir_change_end) {
-      max_slew_fwd = dir > 0 ? max_slew_accel_fwd : 24;
-      max_slew_rev = dir > 0 ? 24 : max_slew_accel_rev;
-      min_speed = true;
-    }
-    if(!dir_change_start && !dir_change_end) {
-      max_slew_fwd = 24;
-      max_slew_rev = 24;
-      min_speed = true;
-    }
-  }
 
   PID pid_distance = PID(distance_kp, distance_ki, distance_kd);
   PID pid_heading = PID(heading_correction_kp, heading_correction_ki, heading_correction_kd);
 
   // Set PID targets for distance and heading
-  pid_distance.setTarget(hypot(x - x_pos, y - y_pos));
-  pid_distance.setIntegralMax(0);  
+  pid_distance.setTarget(controlHypot(x - x_pos, y - y_pos));
+  pid_distance.setIntegralMax(0);
   pid_distance.setIntegralRange(3);
   pid_distance.setSmallBigErrorTolerance(threshold, threshold * 3);
   pid_distance.setSmallBigErrorDuration(50, 250);
   pid_distance.setDerivativeTolerance(5);
-  
-  pid_heading.setTarget(normalizeTarget(radToDeg(atan2(x - x_pos, y - y_pos)) + add));
-  pid_heading.setIntegralMax(0);  
+
+  pid_heading.setTarget(normalizeTarget(radToDeg(controlAtan2(x - x_pos, y - y_pos)) + add));
+  pid_heading.setIntegralMax(0);
   pid_heading.setIntegralRange(1);
-  
+
   pid_heading.setSmallBigErrorTolerance(0, 0);
   pid_heading.setSmallBigErrorDuration(0, 0);
   pid_heading.setDerivativeTolerance(0);
   pid_heading.setArrive(false);
 
-  // Reset the chassis
-  double start_time = Brain.timer(msec);
-  double left_output = 0, right_output = 0, correction_output = 0, prev_left_output = 0, prev_right_output = 0;
-  double exittolerance = 1;
-  bool perpendicular_line = false, prev_perpendicular_line = true;
+  PointError error = { x, y, add, 1, true, controlHypot(x - x_pos, y - y_pos), 0, x_pos, y_pos };
+  PointOutput output = { pid_distance, pid_heading, error, dir, overturn, max_output, true };
+  CrossingExit exit_policy;
+  DriveChain chain(dir, exit, max_output);
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
 
-  double current_angle = 0, overturn_value = 0;
-  bool ch = true;
+  endMotion(exit);
+  correct_angle = getInertialHeading(); // Update global heading
+}
 
-  // Main PID loop for moving to point
-  while (Brain.timer(msec) - start_time <= time_limit_msec) {
-    // Continuously update targets as robot moves
-    pid_heading.setTarget(normalizeTarget(radToDeg(atan2(x - x_pos, y - y_pos)) + add));
-    pid_distance.setTarget(hypot(x - x_pos, y - y_pos));
-    current_angle = getInertialHeading();
-    // Calculate drive output based on heading and distance
-    left_output = pid_distance.update(0) * cos(degToRad(atan2(x - x_pos, y - y_pos) * 180 / M_PI + add - current_angle)) * dir;
-    right_output = left_output;
+/*
+ * CarrotError
+ * Error source for boomerang: the carrot point leading the target along the final heading,
+ * and the exit line through the target perpendicular to the final heading.
+ */
+struct CarrotError {
+  double x, y, a, dlead;
+  int add;
+  double exit_tolerance;
+  bool prev_perpendicular_line;
+  // Progress tracking for motion markers
+  double start_distance, traveled, prev_x, prev_y;
+  double carrot_x, carrot_y;
+
+  void measure(ControlState& state) {
+    double hypotenuse = controlHypot(x_pos - x, y_pos - y); // Distance to target
+    traveled += controlHypot(x_pos - prev_x, y_pos - prev_y);
+    prev_x = x_pos;
+    prev_y = y_pos;
+    updateMarkers(traveled, hypotenuse, markerPercent(start_distance - hypotenuse, start_distance));
+    // Calculate carrot point for path leading
+    carrot_x = x - hypotenuse * controlSin(degToRad(a + add)) * dlead;
+    carrot_y = y - hypotenuse * controlCos(degToRad(a + add)) * dlead;
+    state.heading = getInertialHeading();
     // Check if robot has crossed the perpendicular line to the target
-    perpendicular_line = ((y_pos - y) * -cos(degToRad(normalizeTarget(current_angle + add))) <= (x_pos - x) * sin(degToRad(normalizeTarget(current_angle + add))) + exittolerance);
-    if(perpendicular_line && !prev_perpendicular_line) {
-      break;
-    }
+    bool perpendicular_line = ((y_pos - y) * -controlCos(degToRad(normalizeTarget(a))) <= (x_pos - x) * controlSin(degToRad(normalizeTarget(a))) + exit_tolerance);
+    state.crossed = perpendicular_line && !prev_perpendicular_line;
     prev_perpendicular_line = perpendicular_line;
+  }
+};
+
+// Output map for boomerang: chases the carrot, then the target, then holds the final heading.
+struct CarrotOutput {
+  PID& pid_distance;
+  PID& pid_heading;
+  CarrotError& error;
+  int dir;
+  bool exit, overturn;
+  double max_output;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    double x = error.x, y = error.y, carrot_x = error.carrot_x, carrot_y = error.carrot_y;
+    pid_distance.setTarget(controlHypot(carrot_x - x_pos, carrot_y - y_pos) * dir);
+    // Calculate drive output based on carrot point
+    double drive_output = pid_distance.update(0) * controlCos(degToRad(controlAtan2(carrot_x - x_pos, carrot_y - y_pos) * 180 / M_PI + error.add - state.heading));
+    state.arrived = pid_distance.targetArrived();
+    state.left_output = drive_output;
+    state.right_output = drive_output;
+    chain.minimum(state.left_output, state.right_output);
+    drive_output = state.left_output;
 
-    // Only apply heading correction if far from target
-    if(hypot(x - x_pos, y - y_pos) > 8 && ch == true) {
-      correction_output = pid_heading.update(current_angle);
+    // Heading correction logic based on distance to carrot/target
+    bool final_heading = false;
+    if(controlHypot(carrot_x - x_pos, carrot_y - y_pos) > 8) {
+      state.target_heading = normalizeTarget(radToDeg(controlAtan2(carrot_x - x_pos, carrot_y - y_pos)) + error.add);
+    } else if(controlHypot(x - x_pos, y - y_pos) > 6) {
+      state.target_heading = normalizeTarget(radToDeg(controlAtan2(x - x_pos, y - y_pos)) + error.add);
     } else {
-      correction_output = 0;
-      ch = false;
+      state.target_heading = normalizeTarget(error.a);
+      final_heading = true;
     }
-
-    // Minimum Output Check
-    if(min_speed) {
-      scaleToMin(left_output, right_output, min_output);
+    pid_heading.setTarget(state.target_heading);
+    double correction_output = pid_heading.update(state.heading);
+    if(final_heading && exit && controlHypot(x - x_pos, y - y_pos) < 5) {
+      state.crossed = true;
+      return;
     }
 
-    // Overturn logic for sharp turns
-    overturn_value = fabs(left_output) + fabs(correction_output) - max_output;
-    if(overturn_value > 0 && overturn) {
-      if(left_output > 0) {
-        left_output -= overturn_value;
-      }
-      else {
-        left_output += overturn_value;
-      }
+    // Limit slip speed for smoother curves
+    double slip_speed = sqrt(chase_power * getRadius<control_scalar>(x_pos, y_pos, carrot_x, carrot_y, state.heading) * 9.8);
+    if(drive_output > slip_speed) {
+      drive_output = slip_speed;
+    } else if(drive_output < -slip_speed) {
+      drive_output = -slip_speed;
     }
-    right_output = left_output;
-    left_output = left_output + correction_output;
-    right_output = right_output - correction_output;
-
-    // Max Output Check
-    scaleToMax(left_output, right_output, max_output);
 
-    // Max Acceleration/Deceleration Check
-    if(prev_left_output - left_output > max_slew_rev) {
-      left_output = prev_left_output - max_slew_rev;
+    if(overturn) {
+      applyOverturn(drive_output, correction_output, max_output);
     }
-    if(prev_right_output - right_output > max_slew_rev) {
-      right_output = prev_right_output - max_slew_rev;
-    }
-    if(left_output - prev_left_output > max_slew_fwd) {
-      left_output = prev_left_output + max_slew_fwd;
-    }
-    if(right_output - prev_right_output > max_slew_fwd) {
-      right_output = prev_right_output + max_slew_fwd;
-    }
-    prev_left_output = left_output;
-    prev_right_output = right_output;
-    driveChassis(left_output, right_output); // Apply output to chassis
-    wait(10, msec);
+    state.left_output = drive_output + correction_output;
+    state.right_output = drive_output - correction_output;
   }
-  if(exit == true) {
-    prev_left_output = 0;
-    prev_right_output = 0;
-    stopChassis(vex::hold); // Stop at end if required
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
   }
-  correct_angle = getInertialHeading(); // Update global heading
-  is_turning = false;                   // Reset turning state
-}
+};
 
 /*
  * boomerang
@@ -1134,142 +1480,406 @@ void moveToPoint(double x, double y, int dir, double time_limit_msec, bool exit,
  * - overturn: If true, allows overturning for sharp turns.
  */
 void boomerang(double x, double y, int dir, double a, double dlead, double time_limit_msec, bool exit, double max_output, bool overturn) {
-  stopChassis(vex::brakeType::coast); // Stop chassis before moving
-  is_turning = true;                  // Set turning state
+  beginMotion();
   double threshold = 0.5;
   int add = dir > 0 ? 0 : 180;
-  double max_slew_fwd = dir > 0 ? max_slew_accel_fwd : max_slew_decel_rev;
-  double max_slew_rev = dir > 0 ? max_slew_decel_fwd : max_slew_accel_rev;
-  bool min_speed = false;
-  if(!exit) {
-    // Adjust slew rates and min speed for chaining
-    if(!dir_change_start && dir_change_end) {
-      max_slew_fwd = dir > 0 ? 24 : max_slew_decel_rev;
-      max_slew_rev = dir > 0 ? max_slew_decel_fwd : 24;
-    }
-    if(dir_change_start && !dir_change_end) {
-      max_slew_fwd = dir > 0 ? max_slew_accel_fwd : 24;
-      max_slew_rev = dir > 0 ? 24 : max_slew_accel_rev;
-      min_speed = true;
-    }
-    if(!dir_change_start && !dir_change_end) {
-      max_slew_fwd = 24;
-      max_slew_rev = 24;
-      min_speed = true;
-    }
-  }
 
   PID pid_distance = PID(distance_kp, distance_ki, distance_kd);
   PID pid_heading = PID(heading_correction_kp, heading_correction_ki, heading_correction_kd);
 
   pid_distance.setTarget(0); // Target is dynamically updated
-  pid_distance.setIntegralMax(3);  
+  pid_distance.setIntegralMax(3);
   pid_distance.setSmallBigErrorTolerance(threshold, threshold * 3);
   pid_distance.setSmallBigErrorDuration(50, 250);
   pid_distance.setDerivativeTolerance(5);
 
-  pid_heading.setTarget(normalizeTarget(radToDeg(atan2(x - x_pos, y - y_pos))));
-  pid_heading.setIntegralMax(0);  
+  pid_heading.setTarget(normalizeTarget(radToDeg(controlAtan2(x - x_pos, y - y_pos))));
+  pid_heading.setIntegralMax(0);
   pid_heading.setIntegralRange(1);
   pid_heading.setSmallBigErrorTolerance(0, 0);
   pid_heading.setSmallBigErrorDuration(0, 0);
   pid_heading.setDerivativeTolerance(0);
   pid_heading.setArrive(false);
 
-  double start_time = Brain.timer(msec);
-  double left_output = 0, right_output = 0, correction_output = 0, slip_speed = 0, overturn_value = 0;
-  double exit_tolerance = 3;
-  bool perpendicular_line = false, prev_perpendicular_line = true;
-  double current_angle = 0, hypotenuse = 0, carrot_x = 0, carrot_y = 0;
-
-  // Main PID loop for boomerang path
-  while ((!pid_distance.targetArrived()) && Brain.timer(msec) - start_time <= time_limit_msec) {
-    hypotenuse = hypot(x_pos - x, y_pos - y); // Distance to target
-    // Calculate carrot point for path leading
-    carrot_x = x - hypotenuse * sin(degToRad(a + add)) * dlead;
-    carrot_y = y - hypotenuse * cos(degToRad(a + add)) * dlead;
-    pid_distance.setTarget(hypot(carrot_x - x_pos, carrot_y - y_pos) * dir);
-    current_angle = getInertialHeading();
-    // Calculate drive output based on carrot point
-    left_output = pid_distance.update(0) * cos(degToRad(atan2(carrot_x - x_pos, carrot_y - y_pos) * 180 / M_PI + add - current_angle));
-    right_output = left_output;
-    // Check if robot has crossed the perpendicular line to the target
-    perpendicular_line = ((y_pos - y) * -cos(degToRad(normalizeTarget(a))) <= (x_pos - x) * sin(degToRad(normalizeTarget(a))) + exit_tolerance);
-    if(perpendicular_line && !prev_perpendicular_line) {
-      break;
-    }
-    prev_perpendicular_line = perpendicular_line;
+  CarrotError error = { x, y, a, dlead, add, 3, true, controlHypot(x - x_pos, y - y_pos), 0, x_pos, y_pos, 0, 0 };
+  CarrotOutput output = { pid_distance, pid_heading, error, dir, exit, overturn, max_output };
+  SettleExit exit_policy;
+  DriveChain chain(dir, exit, max_output);
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
 
-    // Minimum Output Check
-    if(min_speed) {
-      scaleToMin(left_output, right_output, min_output);
-    }
+  endMotion(exit);
+  correct_angle = a;      // Update global heading
+}
 
-    // Heading correction logic based on distance to carrot/target
-    if(hypot(carrot_x - x_pos, carrot_y - y_pos) > 8) {
-      pid_heading.setTarget(normalizeTarget(radToDeg(atan2(carrot_x - x_pos, carrot_y - y_pos)) + add));
-      correction_output = pid_heading.update(current_angle);
-    } else if(hypot(x - x_pos, y - y_pos) > 6) {
-      pid_heading.setTarget(normalizeTarget(radToDeg(atan2(x - x_pos, y - y_pos)) + add));
-      correction_output = pid_heading.update(current_angle);
-    } else {
-      pid_heading.setTarget(normalizeTarget(a));
-      correction_output = pid_heading.update(current_angle);
-      if(exit && hypot(x - x_pos, y - y_pos) < 5) {
+/*
+ * TrajectoryError
+ * Error source for followTrajectory: the closest sample (only searched forward, so the robot
+ * never goes back along the path) and the pure pursuit curvature to the lookahead sample.
+ * The motion ends when the closest sample is the last one.
+ */
+struct TrajectoryError {
+  Trajectory& trajectory;
+  int dir;
+  double lookahead_in;
+  int last, closest, target;
+  double total_distance, curvature;
+
+  void measure(ControlState& state) {
+    double closest_distance = controlHypot(trajectory.x[closest] - x_pos, trajectory.y[closest] - y_pos);
+    for (int i = closest + 1; i <= last; i++) {
+      double sample_distance = controlHypot(trajectory.x[i] - x_pos, trajectory.y[i] - y_pos);
+      if (sample_distance < closest_distance) {
+        closest_distance = sample_distance;
+        closest = i;
+      } else if (sample_distance > closest_distance + lookahead_in) {
         break;
       }
     }
-
-    // Limit slip speed for smoother curves
-    slip_speed = sqrt(chase_power * getRadius(x_pos, y_pos, carrot_x, carrot_y, current_angle) * 9.8);
-    if(left_output > slip_speed) {
-      left_output = slip_speed;
-    } else if(left_output < -slip_speed) {
-      left_output = -slip_speed;
+    if (closest == last) {
+      state.crossed = true;
+      return;
     }
+    updateMarkers(trajectory.distance[closest], total_distance - trajectory.distance[closest], markerPercent(trajectory.distance[closest], total_distance));
 
-    // Overturn logic for sharp turns
-    overturn_value = fabs(left_output) + fabs(correction_output) - max_output;
-    if(overturn_value > 0 && overturn) {
-      if(left_output > 0) {
-        left_output -= overturn_value;
-      }
-      else {
-        left_output += overturn_value;
-      }
+    // Lookahead point and the curvature of the arc through it
+    target = target > closest ? target : closest;
+    while (target < last && controlHypot(trajectory.x[target] - x_pos, trajectory.y[target] - y_pos) < lookahead_in) {
+      target++;
+    }
+    state.heading = getInertialHeading();
+    double heading_rad = degToRad(state.heading + (dir > 0 ? 0 : 180));
+    double delta_x = trajectory.x[target] - x_pos, delta_y = trajectory.y[target] - y_pos;
+    double lateral = delta_x * controlCos(heading_rad) - delta_y * controlSin(heading_rad);
+    double distance_sq = delta_x * delta_x + delta_y * delta_y;
+    curvature = distance_sq > 1e-6 ? 2 * lateral / distance_sq : 0;
+  }
+};
+
+// Output map for followTrajectory: planned velocity as wheel-speed feedforward along the curvature.
+struct TrajectoryOutput {
+  TrajectoryError& error;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    // Planned velocity one sample ahead, so the robot starts moving from a standstill
+    double velocity = error.trajectory.velocity[error.closest + 1];
+    state.left_output = velocity * (1 + error.curvature * distance_between_wheels / 2) / max_chassis_velocity * 12;
+    state.right_output = velocity * (1 - error.curvature * distance_between_wheels / 2) / max_chassis_velocity * 12;
+    if (error.dir < 0) {
+      // Driving backwards, the path's left side is the robot's right side
+      double temp = state.left_output;
+      state.left_output = -state.right_output;
+      state.right_output = -temp;
     }
-    right_output = left_output;
-    left_output = left_output + correction_output;
-    right_output = right_output - correction_output;
+  }
 
-    // Max Output Check
-    scaleToMax(left_output, right_output, max_output);
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
+  }
+};
 
-    // Max Acceleration/Deceleration Check
-    if(prev_left_output - left_output > max_slew_rev) {
-      left_output = prev_left_output - max_slew_rev;
-    }
-    if(prev_right_output - right_output > max_slew_rev) {
-      right_output = prev_right_output - max_slew_rev;
-    }
-    if(left_output - prev_left_output > max_slew_fwd) {
-      left_output = prev_left_output + max_slew_fwd;
-    }
-    if(right_output - prev_right_output > max_slew_fwd) {
-      right_output = prev_right_output + max_slew_fwd;
+/*
+ * followTrajectory
+ * Follows a trajectory from generateTrajectory. Steers with pure pursuit and uses the
+ * planned velocity as wheel-speed feedforward, so curves run at the traction limit.
+ * - trajectory: Sampled path with its velocity profile.
+ * - dir: Direction to move in (1 for forward, -1 for backward).
+ * - time_limit_msec: Maximum time allowed for the path (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, allows chaining.
+ * - max_output: Maximum voltage output to motors.
+ * - lookahead_in: Pure pursuit lookahead distance (in inches).
+ */
+void followTrajectory(Trajectory& trajectory, int dir, double time_limit_msec, bool exit, double max_output, double lookahead_in) {
+  beginMotion();
+  int last = trajectory.count - 1;
+  if (last > 0) {
+    TrajectoryError error = { trajectory, dir, lookahead_in, last, 0, 0, trajectory.distance[last], 0 };
+    TrajectoryOutput output = { error };
+    CrossingExit exit_policy;
+    DriveChain chain(max_output);
+    runControlLoop(error, output, exit_policy, chain, time_limit_msec);
+  }
+
+  endMotion(exit);
+  correct_angle = getInertialHeading(); // Update global heading
+}
+
+/*
+ * ArcOdomError
+ * Error source for arcTo: progress is the arc phase closest to the robot (unwrapped from the
+ * previous tick), and the heading target holds the arc's tangent, steering toward the center
+ * when outside the arc and away when inside.
+ */
+struct ArcOdomError {
+  double center_x, center_y, center_radius, radius;
+  double start_rad, arc_length;
+  int turn_direction, drive_direction, center_side;
+  double phase_rad, traveled;
+
+  void measure(ControlState& state) {
+    double offset_x = x_pos - center_x, offset_y = y_pos - center_y;
+    double closest_rad = controlAtan2(offset_y / center_radius, -offset_x / center_radius);
+    phase_rad += remainder(closest_rad - phase_rad, 2 * M_PI);
+    traveled = radius * (phase_rad - start_rad) * turn_direction;
+    updateMarkers(traveled, arc_length - traveled, markerPercent(traveled, arc_length));
+
+    double radial_error = controlHypot(offset_x, offset_y) - radius;
+    double steer_rad = controlAtan2(radial_error, line_lookahead_in) * center_side * drive_direction;
+    state.target_heading = normalizeTarget(radToDeg(phase_rad + steer_rad));
+    state.heading = getInertialHeading();
+    state.passed = traveled >= arc_length;
+  }
+};
+
+// Output map for arcTo: distance PID (full speed when chaining) with the curvature feedforward and heading correction.
+struct ArcOdomOutput {
+  PID& pid_distance;
+  PID& pid_heading;
+  ArcOdomError& error;
+  bool exit;
+  double max_output, feedforward;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    pid_heading.setTarget(state.target_heading);
+    double correction_output = pid_heading.update(state.heading);
+
+    double speed_output = exit ? pid_distance.update(error.traveled) * error.drive_direction : max_output * error.drive_direction;
+    state.arrived = pid_distance.targetArrived();
+    state.left_output = speed_output * (1 + feedforward) + correction_output;
+    state.right_output = speed_output * (1 - feedforward) - correction_output;
+  }
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
+  }
+};
+
+/*
+ * arcTo
+ * Drives along a circular arc in the field frame using odometry. The arc starts at the current
+ * position, tangent to correct_angle, and ends where its tangent reaches result_angle_deg, so the
+ * end point and end heading are reached together. Wheel speeds get a curvature feedforward and
+ * heading is steered back onto the arc when the robot drifts off it.
+ * - result_angle_deg: Heading at the end of the arc (in degrees).
+ * - center_radius: Radius of the arc through the tracking center (positive for curve to the right, negative for curve to the left).
+ * - time_limit_msec: Maximum time allowed for the arc (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, allows chaining.
+ * - max_output: Maximum voltage output to motors.
+ */
+void arcTo(double result_angle_deg, double center_radius, double time_limit_msec, bool exit, double max_output) {
+  if (fabs(center_radius) < 1e-3) {
+    turnToAngle(result_angle_deg, time_limit_msec, exit, max_output);
+    return;
+  }
+  beginMotion();
+  double threshold = 0.5;
+
+  result_angle_deg = normalizeTarget(result_angle_deg);
+  double start_rad = degToRad(correct_angle), end_rad = degToRad(result_angle_deg);
+  int turn_direction = end_rad > start_rad ? 1 : -1;
+  // Curving right while turning clockwise (or left while turning counterclockwise) drives forward
+  int drive_direction = (center_radius > 0) == (turn_direction > 0) ? 1 : -1;
+  int center_side = center_radius > 0 ? 1 : -1;
+  double radius = fabs(center_radius);
+  double arc_length = radius * fabs(end_rad - start_rad);
+
+  // Arc center, center_radius to the right of the start position
+  double center_x = x_pos + center_radius * controlCos(start_rad);
+  double center_y = y_pos - center_radius * controlSin(start_rad);
+  // Outer side runs faster by the ratio of the wheel radii
+  double feedforward = distance_between_wheels / (2 * center_radius);
+
+  PID pid_distance = PID(distance_kp, distance_ki, distance_kd);
+  PID pid_heading = PID(heading_correction_kp, heading_correction_ki, heading_correction_kd);
+  pid_distance.setTarget(arc_length);
+  pid_distance.setIntegralMax(3);
+  pid_distance.setSmallBigErrorTolerance(threshold, threshold * 3);
+  pid_distance.setSmallBigErrorDuration(50, 250);
+  pid_distance.setDerivativeTolerance(5);
+
+  pid_heading.setIntegralMax(0);
+  pid_heading.setIntegralRange(1);
+  pid_heading.setSmallBigErrorTolerance(0, 0);
+  pid_heading.setSmallBigErrorDuration(0, 0);
+  pid_heading.setDerivativeTolerance(0);
+  pid_heading.setArrive(false);
+
+  ArcOdomError error = { center_x, center_y, center_radius, radius, start_rad, arc_length,
+                         turn_direction, drive_direction, center_side, start_rad, 0 };
+  ArcOdomOutput output = { pid_distance, pid_heading, error, exit, max_output, feedforward };
+  // Settled once at the end point and within 1 degree of the end heading
+  SettleAtHeadingExit exit_policy = { exit, result_angle_deg, 1 };
+  DriveChain chain(max_output, max_slew_accel_fwd);
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
+
+  endMotion(exit);
+  correct_angle = result_angle_deg;
+}
+
+/*
+ * swingTo
+ * Swings around one side of the drive using odometry: an arcTo whose center is the stationary side.
+ * - swing_angle: Target heading (in degrees).
+ * - drive_direction: 1 to swing forward, -1 to swing backward.
+ * - time_limit_msec: Maximum time allowed for the swing (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, allows chaining.
+ * - max_output: Maximum voltage output to motors.
+ */
+void swingTo(double swing_angle, int drive_direction, double time_limit_msec, bool exit, double max_output) {
+  swing_angle = normalizeTarget(swing_angle);
+  int turn_direction = swing_angle > correct_angle ? 1 : -1;
+  arcTo(swing_angle, turn_direction * drive_direction * distance_between_wheels / 2, time_limit_msec, exit, max_output);
+}
+
+// ============================================================================
+// CONTACT-TERMINATED MOTIONS
+// ============================================================================
+
+// Error source for contact motions: holds the heading and ends the motion once the
+// condition has been detected for required_ticks control ticks in a row.
+template <typename Condition>
+struct ContactError {
+  Condition condition;
+  double hold_heading;
+  int required_ticks, detected_ticks;
+
+  void measure(ControlState& state) {
+    state.heading = getInertialHeading();
+    state.target_heading = hold_heading;
+    detected_ticks = condition.detected() ? detected_ticks + 1 : 0;
+    state.crossed = detected_ticks >= required_ticks;
+  }
+};
+
+// Output map for contact motions: constant voltage, plus heading correction when holding the heading.
+struct ContactOutput {
+  PID& pid_heading;
+  double voltage;
+  bool hold_heading;
+
+  template <typename ChainPolicy>
+  void compute(ControlState& state, ChainPolicy& chain) {
+    double correction_output = hold_heading ? pid_heading.update(state.heading) : 0;
+    state.left_output = voltage + correction_output;
+    state.right_output = voltage - correction_output;
+  }
+
+  void apply(const ControlState& state) {
+    driveChassis(state.left_output, state.right_output);
+  }
+};
+
+/*
+ * Drives at a constant voltage until the condition ends the motion or time runs out.
+ * last_motion.timed_out is false when the condition ended it.
+ */
+template <typename Condition>
+void driveUntil(Condition condition, int required_ticks, double voltage, double time_limit_msec, bool exit, bool hold_heading) {
+  beginMotion();
+  PID pid_heading = PID(heading_correction_kp, heading_correction_ki, heading_correction_kd);
+  pid_heading.setTarget(normalizeTarget(correct_angle));
+  pid_heading.setIntegralMax(0);
+  pid_heading.setIntegralRange(1);
+  pid_heading.setSmallBigErrorTolerance(0, 0);
+  pid_heading.setSmallBigErrorDuration(0, 0);
+  pid_heading.setDerivativeTolerance(0);
+  pid_heading.setArrive(false);
+
+  ContactError<Condition> error = { condition, normalizeTarget(correct_angle), required_ticks, 0 };
+  ContactOutput output = { pid_heading, voltage, hold_heading };
+  CrossingExit exit_policy;
+  DriveChain chain(voltage > 0 ? 1 : -1, true, 12);
+  runControlLoop(error, output, exit_policy, chain, time_limit_msec);
+
+  endMotion(exit);
+}
+
+/*
+ * StallCondition
+ * Both sides of the drive below stall_velocity_rpm while drawing stall_current_amp or more.
+ * Armed once the drive has moved faster than stall_velocity_rpm or after stall_grace_msec,
+ * so the current spike of starting from a standstill is not taken for a stall.
+ */
+struct StallCondition {
+  double start_time;
+  bool armed;
+
+  bool detected() {
+    double velocity = fmin(fabs(left_chassis.velocity(rpm)), fabs(right_chassis.velocity(rpm)));
+    if (!armed) {
+      armed = velocity > stall_velocity_rpm || Brain.timer(msec) - start_time >= stall_grace_msec;
+      return false;
     }
-    prev_left_output = left_output;
-    prev_right_output = right_output;
-    driveChassis(left_output, right_output); // Apply output to chassis
-    wait(10, msec);
+    double current = (left_chassis1.current(amp) + left_chassis2.current(amp) + left_chassis3.current(amp) +
+                      right_chassis1.current(amp) + right_chassis2.current(amp) + right_chassis3.current(amp)) / 6;
+    return velocity < stall_velocity_rpm && current >= stall_current_amp;
   }
-  if(exit) {
-    prev_left_output = 0;
-    prev_right_output = 0;
-    stopChassis(vex::hold); // Stop at end if required
+};
+
+// A distance sensor sees an object closer than distance_in.
+struct DistanceCondition {
+  vex::distance* sensor;
+  double distance_in;
+
+  bool detected() {
+    return sensor->isObjectDetected() && sensor->objectDistance(inches) < distance_in;
   }
-  correct_angle = a;      // Update global heading
-  is_turning = false;     // Reset turning state
+};
+
+// The inertial sensor's forward acceleration drops faster than contact_jerk against the drive direction.
+struct ImpactCondition {
+  int drive_direction;
+  double prev_accel_g;
+
+  bool detected() {
+    double accel_g = inertial_sensor.acceleration(yaxis);
+    double jerk = (accel_g - prev_accel_g) / 0.01;
+    prev_accel_g = accel_g;
+    return jerk * drive_direction < -contact_jerk;
+  }
+};
+
+/*
+ * driveUntilStalled
+ * Drives until the robot is stopped by an obstacle (a wall, a goal), detected from drive
+ * velocity and current within two control ticks.
+ * - voltage: Drive voltage (positive forward, negative backward).
+ * - time_limit_msec: Maximum time allowed for the move (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, keeps the last output running.
+ * - hold_heading: If true, corrects heading to correct_angle; set false to let the robot square against a wall.
+ */
+void driveUntilStalled(double voltage, double time_limit_msec, bool exit, bool hold_heading) {
+  StallCondition condition = { Brain.timer(msec), false };
+  driveUntil(condition, 2, voltage, time_limit_msec, exit, hold_heading);
+}
+
+/*
+ * driveUntilDistance
+ * Drives until a distance sensor sees an object within distance_in.
+ * - sensor: Distance sensor facing the object.
+ * - distance_in: Distance that ends the motion (in inches).
+ * - voltage: Drive voltage (positive forward, negative backward).
+ * - time_limit_msec: Maximum time allowed for the move (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, keeps the last output running.
+ */
+void driveUntilDistance(vex::distance& sensor, double distance_in, double voltage, double time_limit_msec, bool exit) {
+  DistanceCondition condition = { &sensor, distance_in };
+  driveUntil(condition, 1, voltage, time_limit_msec, exit, true);
+}
+
+/*
+ * driveUntilContact
+ * Drives until the inertial sensor feels an impact, which ends the motion in the tick after
+ * contact, before the drive has even stalled.
+ * - voltage: Drive voltage (positive forward, negative backward).
+ * - time_limit_msec: Maximum time allowed for the move (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, keeps the last output running.
+ * - hold_heading: If true, corrects heading to correct_angle.
+ */
+void driveUntilContact(double voltage, double time_limit_msec, bool exit, bool hold_heading) {
+  ImpactCondition condition = { voltage > 0 ? 1 : -1, inertial_sensor.acceleration(yaxis) };
+  driveUntil(condition, 1, voltage, time_limit_msec, exit, hold_heading);
 }
 
 // ============================================================================
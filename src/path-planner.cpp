@@ -0,0 +1,354 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "path-planner.h"
+
+#include <cmath>
+#include <stdint.h>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+#define FIELD_CELLS (FIELD_GRID_SIZE * FIELD_GRID_SIZE)
+#define MAX_FIELD_OBSTACLES 16
+#define PATH_CACHE_SIZE 16
+
+struct FieldObstacle {
+  double x1, y1, x2, y2;
+};
+FieldObstacle field_obstacles[MAX_FIELD_OBSTACLES];
+int field_obstacle_count = 0;
+double planner_robot_radius = 9;
+
+// Inflated occupancy grid, one bit per cell, rebuilt lazily after map changes.
+uint32_t occupancy[(FIELD_CELLS + 31) / 32];
+bool occupancy_valid = false;
+
+// A* working memory
+float g_cost[FIELD_CELLS];
+uint16_t parent[FIELD_CELLS];
+uint8_t cell_state[FIELD_CELLS]; // 0 = unseen, 1 = open, 2 = closed
+uint16_t heap[FIELD_CELLS];
+int16_t heap_index[FIELD_CELLS];
+int heap_size = 0;
+uint16_t path_cells[FIELD_CELLS];
+
+struct CachedPath {
+  bool valid;
+  int start_cell, goal_cell;
+  int count;
+  double x[MAX_PATH_WAYPOINTS], y[MAX_PATH_WAYPOINTS];
+};
+CachedPath path_cache[PATH_CACHE_SIZE];
+int next_cache_slot = 0;
+
+// ============================================================================
+// FIELD MAP
+// ============================================================================
+
+void invalidateFieldMap() {
+  occupancy_valid = false;
+  for (int i = 0; i < PATH_CACHE_SIZE; i++) {
+    path_cache[i].valid = false;
+  }
+}
+
+void addFieldObstacle(double x1, double y1, double x2, double y2) {
+  if (field_obstacle_count >= MAX_FIELD_OBSTACLES) {
+    return;
+  }
+  field_obstacles[field_obstacle_count].x1 = fmin(x1, x2);
+  field_obstacles[field_obstacle_count].y1 = fmin(y1, y2);
+  field_obstacles[field_obstacle_count].x2 = fmax(x1, x2);
+  field_obstacles[field_obstacle_count].y2 = fmax(y1, y2);
+  field_obstacle_count++;
+  invalidateFieldMap();
+}
+
+void clearFieldObstacles() {
+  field_obstacle_count = 0;
+  invalidateFieldMap();
+}
+
+void setPlannerRobotRadius(double radius_in) {
+  planner_robot_radius = radius_in;
+  invalidateFieldMap();
+}
+
+double cellCenter(int index) {
+  return (index + 0.5) * FIELD_CELL_IN - FIELD_SIZE_IN / 2.0;
+}
+
+int cellIndex(double coordinate) {
+  int index = (int)floor((coordinate + FIELD_SIZE_IN / 2.0) / FIELD_CELL_IN);
+  if (index < 0) return 0;
+  if (index >= FIELD_GRID_SIZE) return FIELD_GRID_SIZE - 1;
+  return index;
+}
+
+bool cellBlocked(int cell) {
+  return occupancy[cell >> 5] & (1u << (cell & 31));
+}
+
+/*
+ * Rebuilds the occupancy grid with every wall and obstacle grown by the robot radius.
+ */
+void buildFieldMap() {
+  double limit = FIELD_SIZE_IN / 2.0 - planner_robot_radius;
+  for (int i = 0; i < (FIELD_CELLS + 31) / 32; i++) {
+    occupancy[i] = 0;
+  }
+  for (int row = 0; row < FIELD_GRID_SIZE; row++) {
+    for (int col = 0; col < FIELD_GRID_SIZE; col++) {
+      double x = cellCenter(col), y = cellCenter(row);
+      bool blocked = fabs(x) > limit || fabs(y) > limit;
+      for (int i = 0; i < field_obstacle_count && !blocked; i++) {
+        // Distance from the cell center to the rectangle
+        double dx = fmax(fmax(field_obstacles[i].x1 - x, 0.0), x - field_obstacles[i].x2);
+        double dy = fmax(fmax(field_obstacles[i].y1 - y, 0.0), y - field_obstacles[i].y2);
+        blocked = dx * dx + dy * dy <= planner_robot_radius * planner_robot_radius;
+      }
+      if (blocked) {
+        int cell = row * FIELD_GRID_SIZE + col;
+        occupancy[cell >> 5] |= 1u << (cell & 31);
+      }
+    }
+  }
+  occupancy_valid = true;
+}
+
+// ============================================================================
+// A* SEARCH
+// ============================================================================
+
+float octileDistance(int a, int b) {
+  int dx = abs(a % FIELD_GRID_SIZE - b % FIELD_GRID_SIZE);
+  int dy = abs(a / FIELD_GRID_SIZE - b / FIELD_GRID_SIZE);
+  return (dx > dy ? dx - dy : dy - dx) + 1.41421356f * (dx < dy ? dx : dy);
+}
+
+// Binary min-heap on f = g + h with an index table for decrease-key.
+float heapKey(int cell, int goal) {
+  return g_cost[cell] + octileDistance(cell, goal);
+}
+
+void heapSwap(int i, int j) {
+  uint16_t temp = heap[i];
+  heap[i] = heap[j];
+  heap[j] = temp;
+  heap_index[heap[i]] = i;
+  heap_index[heap[j]] = j;
+}
+
+void heapUp(int i, int goal) {
+  while (i > 0 && heapKey(heap[(i - 1) / 2], goal) > heapKey(heap[i], goal)) {
+    heapSwap(i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+}
+
+void heapDown(int i, int goal) {
+  while (true) {
+    int smallest = i, left = 2 * i + 1, right = 2 * i + 2;
+    if (left < heap_size && heapKey(heap[left], goal) < heapKey(heap[smallest], goal)) smallest = left;
+    if (right < heap_size && heapKey(heap[right], goal) < heapKey(heap[smallest], goal)) smallest = right;
+    if (smallest == i) return;
+    heapSwap(i, smallest);
+    i = smallest;
+  }
+}
+
+/*
+ * Whether the search may enter a cell. Blocked cells within one robot radius of
+ * the start are allowed so the robot can leave a pose touching a wall or goal.
+ */
+bool cellTraversable(int cell, int start) {
+  if (!cellBlocked(cell)) {
+    return true;
+  }
+  double dx = cellCenter(cell % FIELD_GRID_SIZE) - cellCenter(start % FIELD_GRID_SIZE);
+  double dy = cellCenter(cell / FIELD_GRID_SIZE) - cellCenter(start / FIELD_GRID_SIZE);
+  return dx * dx + dy * dy <= planner_robot_radius * planner_robot_radius;
+}
+
+/*
+ * Whether the straight segment between two points only crosses cells the search may enter.
+ */
+bool lineOfSight(double x1, double y1, double x2, double y2, int start) {
+  double length = hypot(x2 - x1, y2 - y1);
+  int steps = (int)(length / (FIELD_CELL_IN / 2.0)) + 1;
+  for (int i = 0; i <= steps; i++) {
+    double t = (double)i / steps;
+    int cell = cellIndex(y1 + (y2 - y1) * t) * FIELD_GRID_SIZE + cellIndex(x1 + (x2 - x1) * t);
+    if (!cellTraversable(cell, start)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Runs A* on the 8-connected grid. Diagonal moves may not cut blocked corners.
+ * Returns true if the goal was reached; the path is stored in parent[].
+ */
+bool searchGrid(int start, int goal) {
+  for (int i = 0; i < FIELD_CELLS; i++) {
+    cell_state[i] = 0;
+  }
+  heap_size = 0;
+  g_cost[start] = 0;
+  parent[start] = start;
+  cell_state[start] = 1;
+  heap[0] = start;
+  heap_index[start] = 0;
+  heap_size = 1;
+
+  while (heap_size > 0) {
+    int current = heap[0];
+    heap_size--;
+    if (heap_size > 0) {
+      heap[0] = heap[heap_size];
+      heap_index[heap[0]] = 0;
+      heapDown(0, goal);
+    }
+    if (current == goal) {
+      return true;
+    }
+    cell_state[current] = 2;
+
+    int col = current % FIELD_GRID_SIZE, row = current / FIELD_GRID_SIZE;
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        int next_col = col + dx, next_row = row + dy;
+        if ((dx == 0 && dy == 0) || next_col < 0 || next_row < 0 || next_col >= FIELD_GRID_SIZE || next_row >= FIELD_GRID_SIZE) {
+          continue;
+        }
+        int next = next_row * FIELD_GRID_SIZE + next_col;
+        if (cell_state[next] == 2 || !cellTraversable(next, start)) {
+          continue;
+        }
+        if (dx != 0 && dy != 0 && (!cellTraversable(row * FIELD_GRID_SIZE + next_col, start) || !cellTraversable(next_row * FIELD_GRID_SIZE + col, start))) {
+          continue;
+        }
+        float cost = g_cost[current] + (dx != 0 && dy != 0 ? 1.41421356f : 1.0f);
+        if (cell_state[next] == 0) {
+          g_cost[next] = cost;
+          parent[next] = current;
+          cell_state[next] = 1;
+          heap[heap_size] = next;
+          heap_index[next] = heap_size;
+          heap_size++;
+          heapUp(heap_size - 1, goal);
+        } else if (cost < g_cost[next]) {
+          g_cost[next] = cost;
+          parent[next] = current;
+          heapUp(heap_index[next], goal);
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// ============================================================================
+// PATH PLANNING
+// ============================================================================
+
+int planPath(double start_x, double start_y, double goal_x, double goal_y, double* waypoints_x, double* waypoints_y, int max_waypoints) {
+  if (!occupancy_valid) {
+    buildFieldMap();
+  }
+  int start = cellIndex(start_y) * FIELD_GRID_SIZE + cellIndex(start_x);
+  int goal = cellIndex(goal_y) * FIELD_GRID_SIZE + cellIndex(goal_x);
+  if (cellBlocked(goal)) {
+    return 0;
+  }
+
+  // Cached result for this start/goal cell pair
+  for (int i = 0; i < PATH_CACHE_SIZE; i++) {
+    CachedPath& cached = path_cache[i];
+    if (cached.valid && cached.start_cell == start && cached.goal_cell == goal && cached.count <= max_waypoints) {
+      for (int j = 0; j < cached.count; j++) {
+        waypoints_x[j] = cached.x[j];
+        waypoints_y[j] = cached.y[j];
+      }
+      waypoints_x[cached.count - 1] = goal_x;
+      waypoints_y[cached.count - 1] = goal_y;
+      return cached.count;
+    }
+  }
+
+  if (!searchGrid(start, goal)) {
+    return 0;
+  }
+
+  // Walk back from the goal, keeping only the cells where line of sight
+  // to the previously kept cell breaks (string pulling).
+  uint16_t* cells = path_cells;
+  int cell_count = 0;
+  for (int cell = goal; ; cell = parent[cell]) {
+    cells[cell_count++] = cell;
+    if (cell == start) break;
+  }
+
+  int count = 0;
+  double anchor_x = start_x, anchor_y = start_y;
+  int i = cell_count - 1;
+  while (i > 0) {
+    int next = i - 1;
+    while (next > 0 && lineOfSight(anchor_x, anchor_y, cellCenter(cells[next - 1] % FIELD_GRID_SIZE), cellCenter(cells[next - 1] / FIELD_GRID_SIZE), start)) {
+      next--;
+    }
+    if (next == 0) break;
+    if (count >= max_waypoints - 1) {
+      // The path needs more waypoints than allowed; a truncated one would cut through obstacles
+      return 0;
+    }
+    anchor_x = cellCenter(cells[next] % FIELD_GRID_SIZE);
+    anchor_y = cellCenter(cells[next] / FIELD_GRID_SIZE);
+    waypoints_x[count] = anchor_x;
+    waypoints_y[count] = anchor_y;
+    count++;
+    i = next;
+  }
+  waypoints_x[count] = goal_x;
+  waypoints_y[count] = goal_y;
+  count++;
+
+  CachedPath& slot = path_cache[next_cache_slot];
+  next_cache_slot = (next_cache_slot + 1) % PATH_CACHE_SIZE;
+  slot.valid = true;
+  slot.start_cell = start;
+  slot.goal_cell = goal;
+  slot.count = count;
+  for (int j = 0; j < count; j++) {
+    slot.x[j] = waypoints_x[j];
+    slot.y[j] = waypoints_y[j];
+  }
+  return count;
+}
+
+/*
+ * moveToPointPlanned
+ * Plans a path around the field obstacles to (x, y) and drives it as a chain of moveToPoint calls.
+ * Returns false, without moving the robot, if no path is found.
+ * - x, y: Coordinates of the target point.
+ * - dir: Direction to move in (1 for forward, -1 for backward).
+ * - time_limit_msec: Maximum time allowed for the whole path (in milliseconds).
+ * - exit: If true, stops the robot at the end; if false, allows chaining.
+ * - max_output: Maximum voltage output to motors.
+ */
+bool moveToPointPlanned(double x, double y, int dir, double time_limit_msec, bool exit, double max_output) {
+  double waypoints_x[MAX_PATH_WAYPOINTS], waypoints_y[MAX_PATH_WAYPOINTS];
+  int count = planPath(x_pos, y_pos, x, y, waypoints_x, waypoints_y);
+  if (count == 0) {
+    // Driving straight there would run into the obstacles that block every path
+    return false;
+  }
+  double start_time = Brain.timer(msec);
+  for (int i = 0; i < count; i++) {
+    double remaining_msec = time_limit_msec - (Brain.timer(msec) - start_time);
+    if (remaining_msec <= 0) break;
+    moveToPoint(waypoints_x[i], waypoints_y[i], dir, remaining_msec, i == count - 1 ? exit : false, max_output);
+  }
+  return true;
+}
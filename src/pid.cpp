@@ -5,7 +5,8 @@
 #include <cmath>
 
 // Constructor
-PID::PID(double new_kp, double new_ki, double new_kd)
+template <typename Scalar>
+BasicPID<Scalar>::BasicPID(Scalar new_kp, Scalar new_ki, Scalar new_kd)
   : arrived(false), 
     arrive(true), 
     small_error_tolerance(1), 
@@ -25,59 +26,79 @@ PID::PID(double new_kp, double new_ki, double new_kd)
   arrived = false;
 }
 
-void PID::setCoefficient(double new_kp, double new_ki, double new_kd) {
+template <typename Scalar>
+void BasicPID<Scalar>::setCoefficient(Scalar new_kp, Scalar new_ki, Scalar new_kd) {
   kp = new_kp;
   ki = new_ki;
   kd = new_kd;
 }
 
-void PID::setTarget(double new_target) { 
+template <typename Scalar>
+void BasicPID<Scalar>::setTarget(Scalar new_target) { 
   target = new_target;
 }
 
-void PID::setSmallBigErrorTolerance(double new_small_error_tolerance, double new_big_error_tolerance) { 
+template <typename Scalar>
+void BasicPID<Scalar>::setSmallBigErrorTolerance(Scalar new_small_error_tolerance, Scalar new_big_error_tolerance) { 
   small_error_tolerance = new_small_error_tolerance;
   big_error_tolerance = new_big_error_tolerance;
 }
 
-void PID::setIntegralMax(double new_integral_max) { 
+template <typename Scalar>
+void BasicPID<Scalar>::setIntegralMax(Scalar new_integral_max) { 
   integral_max = new_integral_max;
 }
 
-void PID::setIntegralRange(double new_integral_range) { 
+template <typename Scalar>
+void BasicPID<Scalar>::setIntegralRange(Scalar new_integral_range) { 
   integral_range = new_integral_range;
 }
 
-void PID::clearSumError() { 
+template <typename Scalar>
+void BasicPID<Scalar>::clearSumError() { 
   sum_error = 0;
 }
 
-void PID::setDerivativeTolerance(double new_derivative_tolerance) { 
+template <typename Scalar>
+void BasicPID<Scalar>::reset() {
+  first_time = true;
+  arrived = false;
+  sum_error = 0;
+}
+
+template <typename Scalar>
+void BasicPID<Scalar>::setDerivativeTolerance(Scalar new_derivative_tolerance) { 
   derivative_tolerance = new_derivative_tolerance;
 }
 
-void PID::setSmallBigErrorDuration(double new_small_error_duration, double new_big_error_duration) { 
+template <typename Scalar>
+void BasicPID<Scalar>::setSmallBigErrorDuration(double new_small_error_duration, double new_big_error_duration) { 
   small_error_duration = new_small_error_duration;
   big_error_duration = new_big_error_duration;
 }
 
-void PID::setArrive(bool new_arrive) {
+template <typename Scalar>
+void BasicPID<Scalar>::setArrive(bool new_arrive) {
   arrive = new_arrive;
 }
 
-bool PID::targetArrived() { 
+template <typename Scalar>
+bool BasicPID<Scalar>::targetArrived() { 
   return arrived;
 }
 
-double PID::getI() { 
+template <typename Scalar>
+Scalar BasicPID<Scalar>::getI() { 
   return ki;
 }
 
-double PID::getOutput() { 
+template <typename Scalar>
+Scalar BasicPID<Scalar>::getOutput() { 
   return output;
 }
 
-int PID::sign(double number) {
+template <typename Scalar>
+int BasicPID<Scalar>::sign(Scalar number) {
   if (number > 0) {
     return 1;
   } else if (number < 0) {
@@ -86,7 +107,8 @@ int PID::sign(double number) {
   return 0;
 }
 
-double PID::update(double input) {
+template <typename Scalar>
+Scalar BasicPID<Scalar>::update(Scalar input) {
   // Calculate current error
   current_error = target - input; 
   if (first_time) {
@@ -159,3 +181,6 @@ double PID::update(double input) {
   return output;
 }
 
+// Explicit instantiations for both control scalar types
+template class BasicPID<float>;
+template class BasicPID<double>;
@@ -0,0 +1,121 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "pose-history.h"
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// Ring buffer, oldest pose at pose_history_start
+PoseSample pose_history[POSE_HISTORY_SIZE];
+int pose_history_start = 0;
+int pose_history_count = 0;
+
+/*
+ * Pose by age order, 0 is the oldest recorded pose.
+ */
+PoseSample& historyAt(int index) {
+  return pose_history[(pose_history_start + index) % POSE_HISTORY_SIZE];
+}
+
+void recordPose(double time_msec, double x, double y, double heading) {
+  PoseSample sample = { time_msec, x, y, heading };
+  if (pose_history_count < POSE_HISTORY_SIZE) {
+    historyAt(pose_history_count) = sample;
+    pose_history_count++;
+  } else {
+    pose_history[pose_history_start] = sample;
+    pose_history_start = (pose_history_start + 1) % POSE_HISTORY_SIZE;
+  }
+}
+
+void clearPoseHistory() {
+  pose_history_start = 0;
+  pose_history_count = 0;
+}
+
+/*
+ * Index of the last pose recorded at or before time_msec (binary search), -1 if none.
+ */
+int historyIndexBefore(double time_msec) {
+  int low = 0, high = pose_history_count - 1, found = -1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    if (historyAt(mid).time_msec <= time_msec) {
+      found = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  return found;
+}
+
+bool poseAt(double time_msec, PoseSample& pose) {
+  if (pose_history_count == 0) {
+    PoseSample current = { time_msec, x_pos, y_pos, getInertialHeading() };
+    pose = current;
+    return false;
+  }
+  int index = historyIndexBefore(time_msec);
+  if (index < 0) {
+    pose = historyAt(0);
+    return false;
+  }
+  if (index == pose_history_count - 1) {
+    pose = historyAt(index);
+    return time_msec == pose.time_msec;
+  }
+
+  // Interpolate between the surrounding poses
+  PoseSample& before = historyAt(index);
+  PoseSample& after = historyAt(index + 1);
+  double span = after.time_msec - before.time_msec;
+  double t = span > 0 ? (time_msec - before.time_msec) / span : 0;
+  pose.time_msec = time_msec;
+  pose.x = before.x + (after.x - before.x) * t;
+  pose.y = before.y + (after.y - before.y) * t;
+  pose.heading = before.heading + (after.heading - before.heading) * t;
+  return true;
+}
+
+PoseSample predictPose(double time_msec, double velocity_window_msec) {
+  PoseSample latest = { time_msec, x_pos, y_pos, getInertialHeading() };
+  if (pose_history_count < 2) {
+    return latest;
+  }
+  latest = historyAt(pose_history_count - 1);
+  PoseSample earlier;
+  poseAt(latest.time_msec - velocity_window_msec, earlier);
+  double span = latest.time_msec - earlier.time_msec;
+  if (span <= 0) {
+    return latest;
+  }
+
+  // Constant velocity from the latest pose
+  double scale = (time_msec - latest.time_msec) / span;
+  PoseSample predicted;
+  predicted.time_msec = time_msec;
+  predicted.x = latest.x + (latest.x - earlier.x) * scale;
+  predicted.y = latest.y + (latest.y - earlier.y) * scale;
+  predicted.heading = latest.heading + (latest.heading - earlier.heading) * scale;
+  return predicted;
+}
+
+bool applyDelayedPosition(double time_msec, double measured_x, double measured_y) {
+  PoseSample pose;
+  if (!poseAt(time_msec, pose)) {
+    return false;
+  }
+  double error_x = measured_x - pose.x;
+  double error_y = measured_y - pose.y;
+
+  // Everything recorded after the measurement inherits the correction
+  for (int i = historyIndexBefore(time_msec) + 1; i < pose_history_count; i++) {
+    historyAt(i).x += error_x;
+    historyAt(i).y += error_y;
+  }
+  x_pos += error_x;
+  y_pos += error_y;
+  return true;
+}
@@ -0,0 +1,120 @@
+#include "vex.h"
+#include "slip.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+bool slipping = false;
+int slip_ticks = 0, grip_ticks = 0;
+double reference_velocity = 0; // Robot velocity without the drive encoders (in inches per second)
+double slip_distance = 0;
+double traction_scale = 1;
+// Travel summed over the current slip window, and its length so far (in inches, seconds)
+double window_encoder_in = 0, window_tracker_in = 0, window_sec = 0;
+
+// Gravities to inches per second squared
+const double g_in_per_sec_sq = 386.09;
+// Velocities are compared over windows this long whatever the odometry step, so encoder
+// quantization over a short sub-step is not mistaken for slip (in seconds)
+const double slip_window_sec = 0.01;
+// Fraction of the gap to the encoder velocity closed every window while gripping
+const double reference_gain = 0.3;
+// Time constant the reference velocity decays with while slipping (in seconds)
+const double slip_decay_sec = 0.15;
+// Windows the velocity gap must last to enter and to leave slip
+const int slip_enter_ticks = 2;
+const int slip_exit_ticks = 3;
+// Traction scale recovery per window after the slip ends
+const double traction_recovery = 0.05;
+
+/*
+ * Updates the slip state from the velocities over one window.
+ * - encoder_velocity: Forward velocity from the drive encoders (in inches per second).
+ */
+void updateSlip(double encoder_velocity) {
+  double gap = fabs(encoder_velocity - reference_velocity);
+  if (!slipping) {
+    slip_ticks = gap > slip_velocity_threshold ? slip_ticks + 1 : 0;
+    if (slip_ticks >= slip_enter_ticks) {
+      slipping = true;
+      grip_ticks = 0;
+    }
+  } else {
+    bool gripping = gap < slip_velocity_threshold / 2 || fabs(encoder_velocity) < slip_velocity_threshold;
+    grip_ticks = gripping ? grip_ticks + 1 : 0;
+    if (grip_ticks >= slip_exit_ticks) {
+      slipping = false;
+      slip_ticks = 0;
+    }
+  }
+
+  if (slipping) {
+    traction_scale = traction_slip_scale;
+  } else if (traction_scale < 1) {
+    traction_scale = fmin(traction_scale + traction_recovery, 1);
+  }
+}
+
+double slipForward(double encoder_forward_in, double tracker_forward_in, bool has_tracker, double dt_sec) {
+  if (!slip_detection || dt_sec <= 0) {
+    return has_tracker ? tracker_forward_in : encoder_forward_in;
+  }
+  if (!has_tracker) {
+    // Integrate the forward acceleration every step; decay toward a standstill while the
+    // wheels slip (slip is almost always against an obstacle)
+    reference_velocity += inertial_sensor.acceleration(yaxis) * g_in_per_sec_sq * dt_sec;
+    if (slipping) {
+      reference_velocity -= reference_velocity * dt_sec / slip_decay_sec;
+    }
+  }
+
+  // Compare the velocities once the window is complete
+  window_encoder_in += encoder_forward_in;
+  window_tracker_in += tracker_forward_in;
+  window_sec += dt_sec;
+  if (window_sec >= slip_window_sec - 1e-9) {
+    double encoder_velocity = window_encoder_in / window_sec;
+    if (has_tracker) {
+      reference_velocity = window_tracker_in / window_sec;
+    } else if (!slipping && fabs(encoder_velocity - reference_velocity) <= slip_velocity_threshold) {
+      // Follow the encoders while they grip; a gap that may be slip starting is not blended away
+      reference_velocity += reference_gain * (encoder_velocity - reference_velocity);
+    }
+    updateSlip(encoder_velocity);
+    window_encoder_in = window_tracker_in = window_sec = 0;
+  }
+
+  if (has_tracker) {
+    if (slipping) {
+      slip_distance += fabs(encoder_forward_in - tracker_forward_in);
+    }
+    return tracker_forward_in;
+  }
+  if (!slipping) {
+    return encoder_forward_in;
+  }
+  // Trust the encoders only as far as the reference velocity
+  double trusted_in = reference_velocity * dt_sec;
+  if (trusted_in * encoder_forward_in < 0) {
+    trusted_in = 0;
+  } else if (fabs(trusted_in) > fabs(encoder_forward_in)) {
+    trusted_in = encoder_forward_in;
+  }
+  slip_distance += fabs(encoder_forward_in - trusted_in);
+  return trusted_in;
+}
+
+bool isSlipping() {
+  return slipping;
+}
+
+double getSlipDistance() {
+  return slip_distance;
+}
+
+double getTractionScale() {
+  return slip_detection ? traction_scale : 1;
+}
@@ -0,0 +1,102 @@
+#include "vex.h"
+#include "trajectory.h"
+
+#include <cmath>
+
+/*
+ * Signed curvature of the circle through three points (positive when the path
+ * bends right, matching the clockwise heading convention used by odometry).
+ */
+double threePointCurvature(double x1, double y1, double x2, double y2, double x3, double y3) {
+  double a = hypot(x2 - x1, y2 - y1);
+  double b = hypot(x3 - x2, y3 - y2);
+  double c = hypot(x3 - x1, y3 - y1);
+  if (a * b * c < 1e-9) {
+    return 0;
+  }
+  double cross = (x2 - x1) * (y3 - y2) - (y2 - y1) * (x3 - x2);
+  return -2 * cross / (a * b * c);
+}
+
+double generateTrajectory(Trajectory& trajectory, const double* waypoints_x, const double* waypoints_y, int waypoint_count,
+                          double max_velocity, double max_accel, double max_lateral_accel,
+                          double start_velocity, double end_velocity, double spacing_in) {
+  trajectory.count = 0;
+  if (waypoint_count < 1) {
+    return 0;
+  }
+
+  // Sample the polyline at even spacing
+  double carried = 0;
+  trajectory.x[0] = waypoints_x[0];
+  trajectory.y[0] = waypoints_y[0];
+  trajectory.distance[0] = 0;
+  int count = 1;
+  for (int i = 1; i < waypoint_count; i++) {
+    double dx = waypoints_x[i] - waypoints_x[i - 1], dy = waypoints_y[i] - waypoints_y[i - 1];
+    double length = hypot(dx, dy);
+    double s = spacing_in - carried;
+    while (s <= length) {
+      if (count >= MAX_TRAJECTORY_POINTS) {
+        // Too long for the spacing; a shortened trajectory would stop short of the goal
+        return -1;
+      }
+      trajectory.x[count] = waypoints_x[i - 1] + dx * s / length;
+      trajectory.y[count] = waypoints_y[i - 1] + dy * s / length;
+      trajectory.distance[count] = trajectory.distance[count - 1] + spacing_in;
+      count++;
+      s += spacing_in;
+    }
+    carried = length - (s - spacing_in);
+  }
+  // Always end exactly on the last waypoint
+  if (carried > 1e-6) {
+    if (count >= MAX_TRAJECTORY_POINTS) {
+      return -1;
+    }
+    trajectory.x[count] = waypoints_x[waypoint_count - 1];
+    trajectory.y[count] = waypoints_y[waypoint_count - 1];
+    trajectory.distance[count] = trajectory.distance[count - 1] + carried;
+    count++;
+  }
+  trajectory.count = count;
+
+  // Velocity limit at every sample from curvature
+  for (int i = 0; i < count; i++) {
+    double curvature = 0;
+    if (i > 0 && i < count - 1) {
+      curvature = threePointCurvature(trajectory.x[i - 1], trajectory.y[i - 1], trajectory.x[i], trajectory.y[i],
+                                      trajectory.x[i + 1], trajectory.y[i + 1]);
+    }
+    trajectory.curvature[i] = curvature;
+    // Outer wheel runs at v * (1 + |k| * track / 2)
+    double limit = max_velocity / (1 + fabs(curvature) * distance_between_wheels / 2);
+    if (fabs(curvature) > 1e-9) {
+      limit = fmin(limit, sqrt(max_lateral_accel / fabs(curvature)));
+    }
+    trajectory.velocity[i] = limit;
+  }
+
+  // Forward pass: acceleration limit
+  trajectory.velocity[0] = fmin(trajectory.velocity[0], start_velocity);
+  for (int i = 1; i < count; i++) {
+    double ds = trajectory.distance[i] - trajectory.distance[i - 1];
+    trajectory.velocity[i] = fmin(trajectory.velocity[i], sqrt(trajectory.velocity[i - 1] * trajectory.velocity[i - 1] + 2 * max_accel * ds));
+  }
+
+  // Backward pass: deceleration limit
+  trajectory.velocity[count - 1] = fmin(trajectory.velocity[count - 1], end_velocity);
+  for (int i = count - 2; i >= 0; i--) {
+    double ds = trajectory.distance[i + 1] - trajectory.distance[i];
+    trajectory.velocity[i] = fmin(trajectory.velocity[i], sqrt(trajectory.velocity[i + 1] * trajectory.velocity[i + 1] + 2 * max_accel * ds));
+  }
+
+  // Time stamps assuming constant acceleration between samples
+  trajectory.time[0] = 0;
+  for (int i = 1; i < count; i++) {
+    double ds = trajectory.distance[i] - trajectory.distance[i - 1];
+    double average_velocity = fmax((trajectory.velocity[i] + trajectory.velocity[i - 1]) / 2, 1e-3);
+    trajectory.time[i] = trajectory.time[i - 1] + ds / average_velocity;
+  }
+  return trajectory.time[count - 1];
+}
@@ -0,0 +1,295 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "triggers.h"
+
+#include <cmath>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+enum TriggerCondition {
+  condition_custom,
+  condition_distance_below,
+  condition_hue_in_range,
+  condition_object_near,
+  condition_traveled,
+  condition_time
+};
+
+struct Trigger {
+  bool active;
+  int id;
+  TriggerCondition type;
+  TriggerMode mode;
+  bool (*condition)();
+  void (*action)();
+
+  // Condition parameters, meaning depends on type.
+  vex::distance* distance_sensor;
+  vex::optical* optical_sensor;
+  double low, high;
+
+  // Start values for relative conditions.
+  double start_time, start_left, start_right;
+
+  // Index of this trigger's sensor in the tick's SensorSnapshot, -1 until the next snapshot.
+  int reading;
+
+  double debounce_msec;
+  double true_since;
+  bool previous;
+  bool fired;
+};
+
+Trigger triggers[MAX_TRIGGERS];
+int next_trigger_id = 0;
+
+// Fired state by trigger id, kept after trigger_once triggers are freed.
+bool fired_ids[256];
+
+// Sensor readings taken once per tick and shared by every trigger watching the same device,
+// so two triggers on one sensor see the same value and the sensor is read once.
+struct SensorSnapshot {
+  double time;
+  double left_deg, right_deg;
+  int distance_count, optical_count;
+  vex::distance* distance_sensors[MAX_TRIGGERS];
+  double distance_mm[MAX_TRIGGERS];
+  vex::optical* optical_sensors[MAX_TRIGGERS];
+  double hue[MAX_TRIGGERS];
+  bool near[MAX_TRIGGERS];
+};
+
+SensorSnapshot snapshot;
+
+// ============================================================================
+// TRIGGER REGISTRATION
+// ============================================================================
+
+/*
+ * Claims a free trigger slot and fills in the common fields.
+ * Returns the slot, or 0 if all slots are in use.
+ */
+Trigger* createTrigger(TriggerCondition type, void (*action)(), TriggerMode mode, double debounce_msec) {
+  for (int i = 0; i < MAX_TRIGGERS; i++) {
+    if (!triggers[i].active) {
+      Trigger& trigger = triggers[i];
+      trigger.id = next_trigger_id++;
+      trigger.type = type;
+      trigger.mode = mode;
+      trigger.condition = 0;
+      trigger.action = action;
+      trigger.distance_sensor = 0;
+      trigger.optical_sensor = 0;
+      trigger.low = 0;
+      trigger.high = 0;
+      trigger.start_time = Brain.timer(msec);
+      trigger.start_left = getLeftRotationDegree();
+      trigger.start_right = getRightRotationDegree();
+      trigger.reading = -1;
+      trigger.debounce_msec = debounce_msec;
+      trigger.true_since = -1;
+      trigger.previous = false;
+      trigger.fired = false;
+      fired_ids[trigger.id % 256] = false;
+      trigger.active = true;
+      return &trigger;
+    }
+  }
+  return 0;
+}
+
+int addTrigger(bool (*condition)(), void (*action)(), TriggerMode mode, double debounce_msec) {
+  Trigger* trigger = createTrigger(condition_custom, action, mode, debounce_msec);
+  if (!trigger) return -1;
+  trigger->condition = condition;
+  return trigger->id;
+}
+
+/*
+ * Fires when the distance sensor reads an object closer than distance_mm.
+ */
+int whenDistanceBelow(vex::distance& sensor, double distance_mm, void (*action)(), TriggerMode mode, double debounce_msec) {
+  Trigger* trigger = createTrigger(condition_distance_below, action, mode, debounce_msec);
+  if (!trigger) return -1;
+  trigger->distance_sensor = &sensor;
+  trigger->high = distance_mm;
+  return trigger->id;
+}
+
+/*
+ * Fires when the optical sensor hue is within [min_hue, max_hue].
+ * A range with min_hue > max_hue wraps around 360 (useful for red).
+ */
+int whenHueInRange(vex::optical& sensor, double min_hue, double max_hue, void (*action)(), TriggerMode mode, double debounce_msec) {
+  Trigger* trigger = createTrigger(condition_hue_in_range, action, mode, debounce_msec);
+  if (!trigger) return -1;
+  trigger->optical_sensor = &sensor;
+  trigger->low = min_hue;
+  trigger->high = max_hue;
+  return trigger->id;
+}
+
+/*
+ * Fires when the optical sensor's proximity reports an object.
+ */
+int whenObjectNear(vex::optical& sensor, void (*action)(), TriggerMode mode, double debounce_msec) {
+  Trigger* trigger = createTrigger(condition_object_near, action, mode, debounce_msec);
+  if (!trigger) return -1;
+  trigger->optical_sensor = &sensor;
+  return trigger->id;
+}
+
+/*
+ * Fires once the chassis has traveled distance_in inches (average of both
+ * sides, either direction) since the trigger was added. Turning in place does not count.
+ */
+int whenTraveled(double distance_in, void (*action)(), TriggerMode mode) {
+  Trigger* trigger = createTrigger(condition_traveled, action, mode, 0);
+  if (!trigger) return -1;
+  trigger->high = fabs(distance_in);
+  return trigger->id;
+}
+
+/*
+ * Fires time_msec milliseconds after the trigger was added.
+ */
+int afterTime(double time_msec, void (*action)()) {
+  Trigger* trigger = createTrigger(condition_time, action, trigger_once, 0);
+  if (!trigger) return -1;
+  trigger->high = time_msec;
+  return trigger->id;
+}
+
+void cancelTrigger(int id) {
+  for (int i = 0; i < MAX_TRIGGERS; i++) {
+    if (triggers[i].active && triggers[i].id == id) {
+      triggers[i].active = false;
+    }
+  }
+}
+
+void cancelAllTriggers() {
+  for (int i = 0; i < MAX_TRIGGERS; i++) {
+    triggers[i].active = false;
+  }
+}
+
+bool triggerFired(int id) {
+  if (id < 0) return false;
+  for (int i = 0; i < MAX_TRIGGERS; i++) {
+    if (triggers[i].active && triggers[i].id == id) {
+      return triggers[i].fired;
+    }
+  }
+  return id > next_trigger_id - 256 && fired_ids[id % 256];
+}
+
+// ============================================================================
+// TRIGGER EVALUATION
+// ============================================================================
+
+/*
+ * Reads the chassis and every sensor an active trigger watches, each device once,
+ * and points the triggers at their readings.
+ */
+void takeSnapshot() {
+  snapshot.time = Brain.timer(msec);
+  snapshot.left_deg = getLeftRotationDegree();
+  snapshot.right_deg = getRightRotationDegree();
+  snapshot.distance_count = 0;
+  snapshot.optical_count = 0;
+  for (int i = 0; i < MAX_TRIGGERS; i++) {
+    Trigger& trigger = triggers[i];
+    if (!trigger.active) continue;
+    if (trigger.distance_sensor) {
+      int slot = 0;
+      while (slot < snapshot.distance_count && snapshot.distance_sensors[slot] != trigger.distance_sensor) slot++;
+      if (slot == snapshot.distance_count) {
+        snapshot.distance_sensors[slot] = trigger.distance_sensor;
+        snapshot.distance_mm[slot] = trigger.distance_sensor->objectDistance(mm);
+        snapshot.distance_count++;
+      }
+      trigger.reading = slot;
+    }
+    if (trigger.optical_sensor) {
+      int slot = 0;
+      while (slot < snapshot.optical_count && snapshot.optical_sensors[slot] != trigger.optical_sensor) slot++;
+      if (slot == snapshot.optical_count) {
+        snapshot.optical_sensors[slot] = trigger.optical_sensor;
+        snapshot.hue[slot] = trigger.optical_sensor->hue();
+        snapshot.near[slot] = trigger.optical_sensor->isNearObject();
+        snapshot.optical_count++;
+      }
+      trigger.reading = slot;
+    }
+  }
+}
+
+/*
+ * Returns the raw (not debounced) state of a trigger's condition from the tick's snapshot.
+ */
+bool evaluateCondition(Trigger& trigger) {
+  if ((trigger.distance_sensor || trigger.optical_sensor) && trigger.reading < 0) {
+    // Added after this tick's snapshot was taken
+    return false;
+  }
+  switch (trigger.type) {
+  case condition_custom:
+    return trigger.condition();
+  case condition_distance_below:
+    return snapshot.distance_mm[trigger.reading] < trigger.high;
+  case condition_hue_in_range: {
+    double hue = snapshot.hue[trigger.reading];
+    if (trigger.low <= trigger.high) {
+      return hue >= trigger.low && hue <= trigger.high;
+    }
+    return hue >= trigger.low || hue <= trigger.high;
+  }
+  case condition_object_near:
+    return snapshot.near[trigger.reading];
+  case condition_traveled:
+    return fabs((snapshot.left_deg - trigger.start_left) + (snapshot.right_deg - trigger.start_right)) / 2.0 / 360.0 * wheel_distance_in >= trigger.high;
+  case condition_time:
+    return snapshot.time - trigger.start_time >= trigger.high;
+  }
+  return false;
+}
+
+/*
+ * triggerLoop
+ * Checks every active trigger each tick and runs the actions whose
+ * conditions are met. Started once in runPreAutonomous.
+ */
+void triggerLoop() {
+  while (true) {
+    takeSnapshot();
+    double now = snapshot.time;
+    for (int i = 0; i < MAX_TRIGGERS; i++) {
+      Trigger& trigger = triggers[i];
+      if (!trigger.active) continue;
+      if (trigger.mode == trigger_latched && trigger.fired) continue;
+
+      // Debounce: the condition has to hold for debounce_msec.
+      bool state = evaluateCondition(trigger);
+      if (!state) {
+        trigger.true_since = -1;
+      } else if (trigger.true_since < 0) {
+        trigger.true_since = now;
+      }
+      bool debounced = state && now - trigger.true_since >= trigger.debounce_msec;
+
+      if (debounced && !trigger.previous) {
+        trigger.fired = true;
+        fired_ids[trigger.id % 256] = true;
+        if (trigger.mode == trigger_once) {
+          trigger.active = false;
+        }
+        trigger.action();
+      }
+      trigger.previous = debounced;
+    }
+    wait(10, msec);
+  }
+}
@@ -0,0 +1,312 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "config-store.h"
+#include "tuning.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// Test motion being sampled
+volatile bool test_running = false;
+TuningTest sample_test = tuning_turn;
+double sample_start_heading = 0, sample_start_left = 0, sample_start_right = 0;
+double sample_start_time = 0;
+double sample_sign = 1, sample_target = 0;
+double sample_peak = 0, sample_rise_msec = -1;
+
+// Longest serial command line
+#define TUNING_LINE_SIZE 64
+
+// ============================================================================
+// TEST MOTIONS
+// ============================================================================
+
+/*
+ * Travel of the test motion so far, positive towards the target (degrees or inches).
+ */
+double tuningTravel() {
+  double travel;
+  if (sample_test == tuning_turn) {
+    travel = getInertialHeading() - sample_start_heading;
+  } else {
+    travel = ((getLeftRotationDegree() - sample_start_left) + (getRightRotationDegree() - sample_start_right)) / 2 / 360.0 * wheel_distance_in;
+  }
+  return travel * sample_sign;
+}
+
+/*
+ * Records the furthest travel and the time the target was first reached.
+ */
+void updateTuningSample() {
+  double travel = tuningTravel();
+  if (travel > sample_peak) {
+    sample_peak = travel;
+  }
+  if (sample_rise_msec < 0 && travel >= sample_target) {
+    sample_rise_msec = Brain.timer(msec) - sample_start_time;
+  }
+}
+
+/*
+ * Samples the test motion every 10 msec while it runs.
+ */
+void sampleTuningTest() {
+  while (test_running) {
+    updateTuningSample();
+    wait(10, msec);
+  }
+}
+
+TuningResult runTuningTest(TuningTest test, double amount, double time_limit_msec) {
+  sample_test = test;
+  sample_sign = amount < 0 ? -1 : 1;
+  sample_target = fabs(amount);
+  sample_start_heading = getInertialHeading();
+  sample_start_left = getLeftRotationDegree();
+  sample_start_right = getRightRotationDegree();
+  sample_start_time = Brain.timer(msec);
+  sample_peak = 0;
+  sample_rise_msec = -1;
+
+  test_running = true;
+  thread sampler = thread(sampleTuningTest);
+  if (test == tuning_turn) {
+    turnToAngle(sample_start_heading + amount, time_limit_msec);
+  } else {
+    driveTo(amount, time_limit_msec);
+  }
+  test_running = false;
+  updateTuningSample();
+
+  TuningResult result;
+  result.settle_msec = last_motion.elapsed_msec;
+  result.rise_msec = sample_rise_msec;
+  result.overshoot = sample_peak > sample_target ? sample_peak - sample_target : 0;
+  result.final_error = sample_target - tuningTravel();
+  result.timed_out = last_motion.timed_out;
+  return result;
+}
+
+// ============================================================================
+// SERIAL PROTOCOL
+// ============================================================================
+
+/*
+ * Writes a tunable as name = value.
+ */
+void printTunable(const ConfigEntry& entry, FILE* out) {
+  if (entry.type == config_bool) {
+    fprintf(out, "%s = %s\n", entry.name, getConfigValue(entry) != 0 ? "true" : "false");
+  } else {
+    fprintf(out, "%s = %.9g\n", entry.name, getConfigValue(entry));
+  }
+}
+
+bool tuningCommand(const char* line, FILE* out) {
+  char command[16] = "", name[48] = "", text[32] = "";
+  int fields = sscanf(line, "%15s %47s %31s", command, name, text);
+  if (fields < 1) {
+    return false;
+  }
+
+  if (strcmp(command, "list") == 0) {
+    for (int i = 0; i < getConfigCount(); i++) {
+      const ConfigEntry& entry = getConfigEntry(i);
+      fprintf(out, "%s %.9g %g %g\n", entry.name, getConfigValue(entry), entry.min, entry.max);
+    }
+    fprintf(out, "ok %d\n", getConfigCount());
+    return true;
+  }
+
+  if (strcmp(command, "get") == 0 || strcmp(command, "set") == 0) {
+    const ConfigEntry* entry = fields >= 2 ? findConfig(name) : 0;
+    if (!entry) {
+      fprintf(out, "error unknown tunable\n");
+      return true;
+    }
+    if (command[0] == 's') {
+      double value;
+      if (fields < 3 || !parseConfigValue(*entry, text, value) || !setConfigValue(*entry, value)) {
+        fprintf(out, "error %s takes %g to %g\n", entry->name, entry->min, entry->max);
+        return true;
+      }
+    }
+    fprintf(out, "ok ");
+    printTunable(*entry, out);
+    return true;
+  }
+
+  if (strcmp(command, "turn") == 0 || strcmp(command, "drive") == 0) {
+    TuningTest test = command[0] == 't' ? tuning_turn : tuning_drive;
+    double amount = test == tuning_turn ? tuning_turn_deg : tuning_drive_in;
+    if (fields >= 2 && sscanf(name, "%lf", &amount) != 1) {
+      fprintf(out, "error bad amount\n");
+      return true;
+    }
+    if (test == tuning_turn && fabs(amount) > 180) {
+      fprintf(out, "error turn within 180 degrees\n");
+      return true;
+    }
+    TuningResult result = runTuningTest(test, amount);
+    fprintf(out, "ok %s %g settle_msec=%.0f rise_msec=%.0f overshoot=%.3f final_error=%.3f timed_out=%d\n",
+            command, amount, result.settle_msec, result.rise_msec, result.overshoot, result.final_error, result.timed_out ? 1 : 0);
+    return true;
+  }
+
+  if (strcmp(command, "save") == 0) {
+    fprintf(out, saveConfig() ? "ok saved " CONFIG_FILE "\n" : "error no SD card\n");
+    return true;
+  }
+
+  if (strcmp(command, "load") == 0) {
+    if (!loadConfig(CONFIG_FILE, fields >= 2 ? name : 0)) {
+      fprintf(out, "error no " CONFIG_FILE "\n");
+    } else {
+      fprintf(out, "ok errors=%d\n", getConfigErrors());
+    }
+    return true;
+  }
+
+  fprintf(out, "error unknown command\n");
+  return false;
+}
+
+// ============================================================================
+// CONTROLLER SCREEN
+// ============================================================================
+
+/*
+ * Starting step for a tunable: 1 for ints and bools, else about a tenth of the value's magnitude.
+ */
+double defaultStep(const ConfigEntry& entry) {
+  if (entry.type != config_double) {
+    return 1;
+  }
+  double magnitude = fabs(getConfigValue(entry));
+  if (magnitude == 0) {
+    magnitude = (entry.max - entry.min) / 10;
+  }
+  return pow(10, floor(log10(magnitude)) - 1);
+}
+
+/*
+ * Moves a tunable by steps of step, within its range (bools toggle).
+ */
+void adjustTunable(const ConfigEntry& entry, double step, int steps) {
+  double value = getConfigValue(entry);
+  if (entry.type == config_bool) {
+    value = value != 0 ? 0 : 1;
+  } else {
+    value += step * steps;
+  }
+  if (value < entry.min) value = entry.min;
+  if (value > entry.max) value = entry.max;
+  if (entry.type == config_int) {
+    value = floor(value + 0.5);
+  }
+  setConfigValue(entry, value);
+}
+
+/*
+ * Tunable name, value and step, then the last test result (or the test A runs).
+ */
+void drawTuningScreen(const ConfigEntry& entry, double step, TuningTest test, const TuningResult* result) {
+  controller_1.Screen.clearScreen();
+  controller_1.Screen.setCursor(1, 1);
+  controller_1.Screen.print("%.19s", entry.name);
+  controller_1.Screen.setCursor(2, 1);
+  controller_1.Screen.print("%-9.5g +/-%g", getConfigValue(entry), step);
+  controller_1.Screen.setCursor(3, 1);
+  if (result) {
+    controller_1.Screen.print("%c %.0fms os%.2f", test == tuning_turn ? 'T' : 'D', result->settle_msec, result->overshoot);
+  } else {
+    controller_1.Screen.print("A: %s test", test == tuning_turn ? "turn" : "drive");
+  }
+}
+
+void tuningLoop() {
+  char line[TUNING_LINE_SIZE];
+  int line_length = 0;
+  bool overflow = false;
+
+  int selected = 0;
+  double step = defaultStep(getConfigEntry(selected));
+  TuningTest test = tuning_turn;
+  TuningResult result;
+  bool has_result = false, redraw = true;
+  bool was_up = false, was_down = false, was_left = false, was_right = false;
+  bool was_l1 = false, was_l2 = false, was_a = false, was_b = false, was_x = false;
+
+  while (true) {
+    // Serial commands, one per line
+    int c;
+    while ((c = vexSerialReadChar(1)) >= 0) {
+      if (c == '\n' || c == '\r') {
+        line[line_length] = 0;
+        if (overflow) {
+          printf("error line too long\n");
+        } else if (line_length > 0) {
+          tuningCommand(line, stdout);
+          redraw = true;
+        }
+        fflush(stdout);
+        line_length = 0;
+        overflow = false;
+      } else if (line_length < TUNING_LINE_SIZE - 1) {
+        line[line_length++] = c;
+      } else {
+        overflow = true;
+      }
+    }
+
+    // Controller, acting on button presses
+    bool up = controller_1.ButtonUp.pressing(), down = controller_1.ButtonDown.pressing();
+    bool left = controller_1.ButtonLeft.pressing(), right = controller_1.ButtonRight.pressing();
+    bool l1 = controller_1.ButtonL1.pressing(), l2 = controller_1.ButtonL2.pressing();
+    bool a = controller_1.ButtonA.pressing(), b = controller_1.ButtonB.pressing(), x = controller_1.ButtonX.pressing();
+    if ((up && !was_up) || (down && !was_down)) {
+      selected = (selected + (up ? getConfigCount() - 1 : 1)) % getConfigCount();
+      step = defaultStep(getConfigEntry(selected));
+      redraw = true;
+    }
+    if ((left && !was_left) || (right && !was_right)) {
+      adjustTunable(getConfigEntry(selected), step, right ? 1 : -1);
+      redraw = true;
+    }
+    if ((l1 && !was_l1) || (l2 && !was_l2)) {
+      step *= l1 ? 10 : 0.1;
+      redraw = true;
+    }
+    if (b && !was_b) {
+      test = test == tuning_turn ? tuning_drive : tuning_turn;
+      has_result = false;
+      redraw = true;
+    }
+    if (x && !was_x) {
+      controller_1.Screen.setCursor(3, 1);
+      controller_1.Screen.print(saveConfig() ? "saved          " : "no SD card     ");
+      wait(500, msec);
+      redraw = true;
+    }
+    if (a && !was_a) {
+      result = runTuningTest(test, test == tuning_turn ? tuning_turn_deg : tuning_drive_in);
+      has_result = true;
+      redraw = true;
+    }
+    was_up = up; was_down = down; was_left = left; was_right = right;
+    was_l1 = l1; was_l2 = l2; was_a = a; was_b = b; was_x = x;
+
+    // The controller screen is slow to update, so only redraw on a change
+    if (redraw) {
+      drawTuningScreen(getConfigEntry(selected), step, test, has_result ? &result : 0);
+      redraw = false;
+    }
+    wait(20, msec);
+  }
+}
@@ -10,11 +10,16 @@ double radToDeg(double rad) {
   return (rad * 180 / M_PI);
 }
 
-double getRadius(double x, double y, double x1, double y1, double angle) {
-  double delta_x = x1 - x;
-  double delta_y = y1 - y;
-  if((2 * delta_y * sin(degToRad(90 - angle))) == 0) {
+template <typename Scalar>
+Scalar getRadius(Scalar x, Scalar y, Scalar x1, Scalar y1, Scalar angle) {
+  Scalar delta_x = x1 - x;
+  Scalar delta_y = y1 - y;
+  Scalar sin_angle = sin((Scalar)degToRad(90 - angle));
+  if((2 * delta_y * sin_angle) == 0) {
     return 999;
   }
-  return (delta_x * delta_x + delta_y * delta_y) / (2 * delta_y * sin(degToRad(90 - angle)));
-}
\ No newline at end of file
+  return (delta_x * delta_x + delta_y * delta_y) / (2 * delta_y * sin_angle);
+}
+
+template float getRadius<float>(float x, float y, float x1, float y1, float angle);
+template double getRadius<double>(double x, double y, double x1, double y1, double angle);
\ No newline at end of file
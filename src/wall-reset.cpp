@@ -0,0 +1,78 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "localization.h"
+#include "pose-history.h"
+#include "path-planner.h"
+#include "wall-reset.h"
+#include "../custom/include/robot-config.h"
+
+#include <cmath>
+
+// Push against the wall until the heading holds still this long (in milliseconds) ...
+const double square_still_msec = 100;
+// ... turning less than this per control tick (in degrees)
+const double square_still_deg = 0.05;
+// Longest push after the stall (in milliseconds)
+const double square_max_msec = 500;
+// Sensor beams further than this from a field axis are not used (in degrees)
+const double beam_tolerance_deg = 10;
+
+/*
+ * Heading of a robot squared against the wall, chosen nearest to the current heading.
+ */
+double wallHeading(FieldWall wall, int drive_direction, double current_heading) {
+  double heading = wall * 90 + (drive_direction > 0 ? 0 : 180);
+  return current_heading + remainder(heading - current_heading, 360);
+}
+
+bool squareToWall(FieldWall wall, int drive_direction, double time_limit_msec, vex::distance* sensor, double sensor_angle_deg, double sensor_offset_in) {
+  driveUntilStalled(square_voltage * drive_direction, time_limit_msec, false, false);
+  if (last_motion.timed_out) {
+    stopChassis(vex::hold);
+    return false;
+  }
+
+  // Keep pushing without heading correction until both sides are flat on the wall
+  double start_time = Brain.timer(msec), still_time = 0;
+  double prev_heading = getInertialHeading();
+  while (still_time < square_still_msec && Brain.timer(msec) - start_time < square_max_msec) {
+    driveChassis(square_voltage * drive_direction, square_voltage * drive_direction);
+    wait(10, msec);
+    double heading = getInertialHeading();
+    still_time = fabs(heading - prev_heading) < square_still_deg ? still_time + 10 : 0;
+    prev_heading = heading;
+  }
+
+  double heading = wallHeading(wall, drive_direction, getInertialHeading());
+  resetOdometryHeading(heading);
+  double x = x_pos, y = y_pos;
+
+  // Tracking center distance from the wall is the bumper that touches it
+  double half_field = FIELD_SIZE_IN / 2.0;
+  double inset = drive_direction > 0 ? front_bumper_in : back_bumper_in;
+  if (wall == wall_top) y = half_field - inset;
+  else if (wall == wall_bottom) y = -half_field + inset;
+  else if (wall == wall_right) x = half_field - inset;
+  else x = -half_field + inset;
+
+  // The sensor measures the coordinate along its beam
+  if (sensor && sensor->isObjectDetected()) {
+    double beam_deg = heading + sensor_angle_deg;
+    double axis_deg = round(beam_deg / 90) * 90;
+    if (fabs(beam_deg - axis_deg) < beam_tolerance_deg) {
+      int beam_wall = ((int)(axis_deg / 90) % 4 + 4) % 4;
+      double reach = sensor->objectDistance(inches) + sensor_offset_in;
+      if (beam_wall != wall && (beam_wall + 2) % 4 != wall) {
+        if (beam_wall == wall_right) x = half_field - reach;
+        else if (beam_wall == wall_left) x = -half_field + reach;
+        else if (beam_wall == wall_top) y = half_field - reach;
+        else y = -half_field + reach;
+      }
+    }
+  }
+
+  stopChassis(vex::hold);
+  clearPoseHistory();
+  resetLocalization(x, y);
+  return true;
+}
@@ -0,0 +1,188 @@
+// autonc: compiles autonomous scripts to the bytecode the robot loads from its SD card
+// (auton-script.h), then runs every routine through the robot's own interpreter and motion
+// code against a chassis model, reporting the predicted time of each step.
+//
+// Usage: autonc <script> [-o autons.bin] [-c config.ini] [-p profile] [-r routine] [-n]
+//   -o  Bytecode file to write (default autons.bin), copy it to the SD card
+//   -c  Configuration file to simulate with, as loadConfig reads it on the robot
+//   -p  Profile section of that file
+//   -r  Simulate only this routine
+//   -n  Compile only
+// Exit status: 0 if every routine fits the autonomous period, 1 if one does not, 2 on errors.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "mechanism.h"
+#include "triggers.h"
+#include "config-store.h"
+#include "auton-script.h"
+#include "script-compiler.h"
+#include "sim/chassis-sim.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Length of the autonomous period (in milliseconds)
+#define AUTONOMOUS_TIME_MSEC 15000
+
+// Actions do nothing in simulation, only their timing matters
+void simulatedAction() {}
+
+/*
+ * Whether an opcode is a motion primitive that reports through last_motion.
+ */
+bool isMotion(int opcode) {
+  return opcode >= op_turn_to_angle && opcode <= op_square_to_wall;
+}
+
+/*
+ * Runs a routine step by step from rest at the origin. Returns the predicted duration (in milliseconds).
+ */
+double simulateRoutine(const CompiledScript& script, int index) {
+  const CompiledRoutine& routine = script.routines[index];
+  resetSimulation(0, 0, 0);
+  clearMarkers();
+  cancelAllTriggers();
+  int limit_hits = 0;
+  bool over_budget = false;
+
+  printf("\n%s\n", routine.name.c_str());
+  for (int i = 0; i < getScriptLength(index); i++) {
+    const CompiledInstruction& step = routine.steps[i];
+    double start_time = sim_time_msec;
+    last_motion.timed_out = false;
+    runScriptStep(index, i);
+    if (step.opcode == op_set_pose) {
+      placeSimulation(step.args[0], step.args[1], step.args[2]);
+    }
+    double elapsed = sim_time_msec - start_time;
+
+    const char* note = "";
+    if (isMotion(step.opcode) && last_motion.timed_out) {
+      note = "  hit time limit";
+      limit_hits++;
+    } else if (step.opcode == op_wait_mechanism) {
+      note = "  mechanism not simulated, full wait";
+    }
+    printf("  %3d  line %-4d %-56s %6.0f ms %7.2f s%s", i + 1, step.line, describeInstruction(script, step).c_str(),
+           elapsed, sim_time_msec / 1000, note);
+    if (!over_budget && sim_time_msec > AUTONOMOUS_TIME_MSEC) {
+      over_budget = true;
+      printf("  past %d s", AUTONOMOUS_TIME_MSEC / 1000);
+    }
+    printf("\n");
+  }
+  stopChassis(vex::hold);
+
+  double spare = (AUTONOMOUS_TIME_MSEC - sim_time_msec) / 1000;
+  printf("  total %.2f s of %d s: %s %.2f s, %d step%s hit %s time limit\n", sim_time_msec / 1000, AUTONOMOUS_TIME_MSEC / 1000,
+         spare >= 0 ? "spare" : "OVER by", fabs(spare), limit_hits, limit_hits == 1 ? "" : "s", limit_hits == 1 ? "its" : "their");
+  return sim_time_msec;
+}
+
+int main(int argc, char** argv) {
+  const char* script_file = 0;
+  const char* output_file = "autons.bin";
+  const char* config_file = 0;
+  const char* profile = 0;
+  const char* only_routine = 0;
+  bool simulate = true;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0) {
+      simulate = false;
+    } else if (argv[i][0] == '-' && i + 1 < argc && strchr("ocpr", argv[i][1]) && argv[i][2] == 0) {
+      const char** option = argv[i][1] == 'o' ? &output_file : argv[i][1] == 'c' ? &config_file : argv[i][1] == 'p' ? &profile : &only_routine;
+      *option = argv[++i];
+    } else if (argv[i][0] != '-' && !script_file) {
+      script_file = argv[i];
+    } else {
+      script_file = 0;
+      break;
+    }
+  }
+  if (!script_file) {
+    fprintf(stderr, "usage: autonc <script> [-o autons.bin] [-c config.ini] [-p profile] [-r routine] [-n]\n");
+    return 2;
+  }
+
+  // Compile
+  FILE* file = fopen(script_file, "rb");
+  if (!file) {
+    fprintf(stderr, "autonc: cannot read %s\n", script_file);
+    return 2;
+  }
+  std::string source;
+  char buffer[4096];
+  size_t length;
+  while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    source.append(buffer, length);
+  }
+  fclose(file);
+
+  CompiledScript script;
+  std::string error;
+  if (!compileScript(source, script, error)) {
+    fprintf(stderr, "%s: %s\n", script_file, error.c_str());
+    return 2;
+  }
+  std::vector<unsigned char> bytes = encodeScript(script);
+  file = fopen(output_file, "wb");
+  if (!file || fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+    fprintf(stderr, "autonc: cannot write %s\n", output_file);
+    return 2;
+  }
+  fclose(file);
+  size_t instruction_count = 0;
+  for (size_t r = 0; r < script.routines.size(); r++) {
+    instruction_count += script.routines[r].steps.size();
+  }
+  printf("%s: %d routines, %d instructions, %d actions, %d bytes\n", output_file, (int)script.routines.size(),
+         (int)instruction_count, (int)script.actions.size(), (int)bytes.size());
+  if (!simulate) {
+    return 0;
+  }
+
+  // Load it the way the robot does, with the script's actions and enough mechanisms registered
+  if (config_file) {
+    if (!loadConfig(config_file, profile)) {
+      fprintf(stderr, "autonc: cannot read %s\n", config_file);
+      return 2;
+    }
+    if (getConfigErrors() > 0) {
+      printf("%s: %d lines skipped\n", config_file, getConfigErrors());
+    }
+  }
+  for (size_t i = 0; i < script.actions.size(); i++) {
+    addScriptAction(script.actions[i].c_str(), simulatedAction);
+  }
+  for (size_t r = 0; r < script.routines.size(); r++) {
+    for (size_t i = 0; i < script.routines[r].steps.size(); i++) {
+      const CompiledInstruction& step = script.routines[r].steps[i];
+      if (step.opcode == op_set_mechanism || step.opcode == op_wait_mechanism) {
+        while (getMechanismCount() <= step.args[0] && getMechanismCount() < MAX_MECHANISMS) {
+          registerMechanism(*new Mechanism(*new motor(PORT1), 0, 0, 0));
+        }
+      }
+    }
+  }
+  if (!loadScripts(output_file)) {
+    fprintf(stderr, "autonc: the robot would reject %s: %s\n", output_file, getScriptError());
+    return 2;
+  }
+
+  bool over_budget = false;
+  int simulated = 0;
+  for (int r = 0; r < getScriptCount(); r++) {
+    if (only_routine && strcmp(only_routine, getScriptName(r)) != 0) {
+      continue;
+    }
+    over_budget |= simulateRoutine(script, r) > AUTONOMOUS_TIME_MSEC;
+    simulated++;
+  }
+  if (only_routine && simulated == 0) {
+    fprintf(stderr, "autonc: no routine %s\n", only_routine);
+    return 2;
+  }
+  return over_budget ? 1 : 0;
+}
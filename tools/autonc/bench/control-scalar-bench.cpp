@@ -0,0 +1,68 @@
+// Time per call of the control code in single and double precision (CONTROL_FLOAT): the PID
+// update run every control tick and getRadius. Host timings only show the relative cost;
+// the V5's Cortex-A9 has to be measured on the robot. Drift in each precision: odometry-bench.
+
+#include "vex.h"
+#include "utils.h"
+#include "pid.h"
+
+#include <chrono>
+#include <cstdio>
+
+const int input_count = 4096;
+const int repeats = 1000;
+
+double inputs[input_count];
+volatile double sink;
+
+/*
+ * Nanoseconds per PID update, tracking a moving target as a drive would.
+ */
+template <typename Scalar>
+double timePID() {
+  BasicPID<Scalar> pid(1.5, 0.05, 8);
+  pid.setIntegralRange(3);
+  pid.setSmallBigErrorTolerance(1, 3);
+  pid.setDerivativeTolerance(4.5);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  double sum = 0;
+  for (int r = 0; r < repeats; r++) {
+    pid.setTarget(inputs[r % input_count] * 10);
+    for (int i = 0; i < input_count; i++) {
+      sum += pid.update((Scalar)inputs[i]);
+    }
+  }
+  sink = sum;
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ((double)repeats * input_count);
+}
+
+/*
+ * Nanoseconds per getRadius call.
+ */
+template <typename Scalar>
+double timeRadius() {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  double sum = 0;
+  for (int r = 0; r < repeats; r++) {
+    for (int i = 0; i < input_count; i++) {
+      sum += getRadius<Scalar>(0, 0, (Scalar)inputs[i], (Scalar)(inputs[i] + 24), (Scalar)(inputs[i] * 3));
+    }
+  }
+  sink = sum;
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ((double)repeats * input_count);
+}
+
+int main() {
+  unsigned int bits = 12345;
+  for (int i = 0; i < input_count; i++) {
+    bits = bits * 1103515245u + 12345u;
+    inputs[i] = ((bits >> 8) & 0xffff) / 65536.0 * 40 - 20;
+  }
+
+  printf("control-scalar: ns per call  double   float\n");
+  printf("  PID update                %6.1f  %6.1f\n", timePID<double>(), timePID<float>());
+  printf("  getRadius                 %6.1f  %6.1f\n", timeRadius<double>(), timeRadius<float>());
+  return 0;
+}
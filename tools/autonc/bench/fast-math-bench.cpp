@@ -0,0 +1,63 @@
+// Time per call of the polynomial trig kernels (fast-math.h) against libm on the host.
+// Host timings only show the relative cost; the V5's Cortex-A9 has to be measured on the robot.
+
+#include "fast-math.h"
+
+#include <chrono>
+#include <cstdio>
+
+const int input_count = 4096;
+const int repeats = 2000;
+
+double inputs_x[input_count], inputs_y[input_count];
+float inputs_xf[input_count], inputs_yf[input_count];
+volatile double sink;
+
+/*
+ * Nanoseconds per call of a kernel over the input table.
+ */
+template <typename Kernel>
+double timeKernel(Kernel kernel) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  double sum = 0;
+  for (int r = 0; r < repeats; r++) {
+    for (int i = 0; i < input_count; i++) {
+      sum += kernel(i);
+    }
+  }
+  sink = sum;
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ((double)repeats * input_count);
+}
+
+struct LibSin { double operator()(int i) { return sin(inputs_x[i]); } };
+struct FastSin { double operator()(int i) { return fastSin(inputs_x[i]); } };
+struct LibAtan2 { double operator()(int i) { return atan2(inputs_y[i], inputs_x[i]); } };
+struct FastAtan2 { double operator()(int i) { return fastAtan2(inputs_y[i], inputs_x[i]); } };
+struct LibHypot { double operator()(int i) { return hypot(inputs_x[i], inputs_y[i]); } };
+struct FastHypot { double operator()(int i) { return fastHypot(inputs_x[i], inputs_y[i]); } };
+struct LibSinf { double operator()(int i) { return sinf(inputs_xf[i]); } };
+struct FastSinf { double operator()(int i) { return fastSin(inputs_xf[i]); } };
+struct LibAtan2f { double operator()(int i) { return atan2f(inputs_yf[i], inputs_xf[i]); } };
+struct FastAtan2f { double operator()(int i) { return fastAtan2(inputs_yf[i], inputs_xf[i]); } };
+
+int main() {
+  // Headings within a few turns and field-sized offsets, as the control code sees them
+  unsigned int bits = 12345;
+  for (int i = 0; i < input_count; i++) {
+    bits = bits * 1103515245u + 12345u;
+    inputs_x[i] = ((bits >> 8) & 0xffff) / 65536.0 * 40 - 20;
+    bits = bits * 1103515245u + 12345u;
+    inputs_y[i] = ((bits >> 8) & 0xffff) / 65536.0 * 144 - 72;
+    inputs_xf[i] = inputs_x[i];
+    inputs_yf[i] = inputs_y[i];
+  }
+
+  printf("fast-math: ns per call    libm    fast\n");
+  printf("  sin   (double)        %6.1f  %6.1f\n", timeKernel(LibSin()), timeKernel(FastSin()));
+  printf("  atan2 (double)        %6.1f  %6.1f\n", timeKernel(LibAtan2()), timeKernel(FastAtan2()));
+  printf("  hypot (double)        %6.1f  %6.1f\n", timeKernel(LibHypot()), timeKernel(FastHypot()));
+  printf("  sin   (float)         %6.1f  %6.1f\n", timeKernel(LibSinf()), timeKernel(FastSinf()));
+  printf("  atan2 (float)         %6.1f  %6.1f\n", timeKernel(LibAtan2f()), timeKernel(FastAtan2f()));
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Odometry drift per minute over a skills run: the same simulated drive is replayed through each
+// tracker, with headingLoop as on the robot and exact sensors, so the error left at the end is
+// the trackers' own. The run is repeated at several loop rates (odom_substeps) to trade loop
+// rate against drift per minute.
+// make bench also runs a CONTROL_FLOAT build of this benchmark to show what single precision costs.
+
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "heading.h"
+#include "sim/chassis-sim.h"
+
+#include <cstdio>
+
+// Length of the run (in milliseconds)
+const double run_msec = 60000;
+
+/*
+ * The skills drive, stopping for half a second at the end so the next replay starts from rest
+ * as the robot would.
+ */
+void skillsRun() {
+  simSkillsDrive();
+  if (sim_time_msec >= run_msec) {
+    left_chassis.volts = right_chassis.volts = 0;
+  }
+}
+
+/*
+ * Replays the run through a tracker and headingLoop. Returns the position error at the end (in inches).
+ */
+double replay(void (*tracker)()) {
+  resetSimulation(0, 0, 0);
+  sim_odometry = true;
+  sim_step_hook = skillsRun;
+  void (*tasks[])() = { headingLoop, tracker };
+  simRunTasks(tasks, 2, run_msec + 500);
+  sim_step_hook = 0;
+  sim_odometry = false;
+  stopChassis();
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  return hypot(x_pos - x, y_pos - y);
+}
+
+int main() {
+  using_horizontal_tracker = true;
+  int substeps[] = { 1, 2, 5, 10 };
+  const char* names[] = { "trackNoOdomWheel", "trackXYOdomWheel", "trackParallelOdomWheel" };
+  void (*trackers[])() = { trackNoOdomWheel, trackXYOdomWheel, trackParallelOdomWheel };
+
+  printf("odometry: drift per minute, %s control_scalar\n", sizeof(control_scalar) == sizeof(float) ? "float" : "double");
+  printf("  loop period (odom_substeps)  10 ms (1)  5 ms (2)  2 ms (5)  1 ms (10)\n");
+  for (int i = 0; i < 3; i++) {
+    printf("  %-27s", names[i]);
+    for (int j = 0; j < 4; j++) {
+      odom_substeps = substeps[j];
+      printf(" %9.5f", replay(trackers[i]));
+    }
+    printf(" in\n");
+  }
+  odom_substeps = 1;
+  return 0;
+}
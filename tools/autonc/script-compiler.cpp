@@ -0,0 +1,312 @@
+#include "script-compiler.h"
+#include "auton-script.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+// Names of the FieldWall values (wall-reset.h)
+const char* const wall_names[] = { "wall_top", "wall_right", "wall_bottom", "wall_left" };
+
+// ============================================================================
+// PARSING
+// ============================================================================
+
+/*
+ * Strips leading and trailing whitespace.
+ */
+std::string trimScriptText(const std::string& text) {
+  size_t start = text.find_first_not_of(" \t\r");
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = text.find_last_not_of(" \t\r");
+  return text.substr(start, end - start + 1);
+}
+
+bool isScriptName(const std::string& text) {
+  if (text.empty() || text.size() > SCRIPT_NAME_SIZE || isdigit((unsigned char)text[0])) {
+    return false;
+  }
+  for (size_t i = 0; i < text.size(); i++) {
+    if (!isalnum((unsigned char)text[i]) && text[i] != '_') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Parses one argument of the given kind (see script-format.h). Returns an error message, "" if none.
+ */
+std::string parseScriptArg(char kind, const std::string& text, CompiledScript& script, float& value) {
+  if (kind == 'a') {
+    if (!isScriptName(text)) {
+      return "'" + text + "' is not an action name (up to 16 letters, digits or _)";
+    }
+    for (size_t i = 0; i < script.actions.size(); i++) {
+      if (script.actions[i] == text) {
+        value = i;
+        return "";
+      }
+    }
+    if (script.actions.size() >= MAX_SCRIPT_ACTIONS) {
+      return "more than " + std::to_string(MAX_SCRIPT_ACTIONS) + " actions";
+    }
+    value = script.actions.size();
+    script.actions.push_back(text);
+    return "";
+  }
+
+  if (kind == 'w') {
+    for (int i = 0; i < 4; i++) {
+      if (text == wall_names[i]) {
+        value = i;
+        return "";
+      }
+    }
+  }
+  if (kind == 'b' && (text == "true" || text == "false")) {
+    value = text == "true" ? 1 : 0;
+    return "";
+  }
+
+  char* end;
+  double number = strtod(text.c_str(), &end);
+  if (text.empty() || *end != 0 || !std::isfinite(number)) {
+    if (kind == 'w') {
+      return "'" + text + "' is not a wall (wall_top, wall_right, wall_bottom or wall_left)";
+    }
+    return "'" + text + "' is not a number";
+  }
+  value = number;
+  bool valid = true;
+  switch (kind) {
+  case 't': valid = value > 0; break;
+  case 'b': valid = value == 0 || value == 1; break;
+  case 'd': valid = value == 1 || value == -1; break;
+  case 'v': valid = value >= 0 && value <= 12; break;
+  case 'w': valid = value == floor(value) && value >= 0 && value < 4; break;
+  case 'm': valid = value == floor(value) && value >= 0; break;
+  }
+  if (!valid) {
+    const char* expected = kind == 't' ? "a time above 0" : kind == 'b' ? "true or false" : kind == 'd' ? "1 or -1" :
+                           kind == 'v' ? "a voltage from 0 to 12" : kind == 'w' ? "a wall" : "a mechanism index";
+    return "'" + text + "' should be " + expected;
+  }
+  return "";
+}
+
+/*
+ * Parses a call such as driveTo(24, 2000, false) into an instruction. Returns an error message, "" if none.
+ */
+std::string parseScriptCall(const std::string& text, CompiledScript& script, CompiledInstruction& instruction) {
+  size_t open = text.find('('), close = text.rfind(')');
+  if (open == std::string::npos || close == std::string::npos || close < open || trimScriptText(text.substr(close + 1)) != "") {
+    return "expected a call like driveTo(24, 2000)";
+  }
+  std::string name = trimScriptText(text.substr(0, open));
+  instruction.opcode = -1;
+  for (int i = 0; i < SCRIPT_OPCODE_COUNT; i++) {
+    if (name == script_opcodes[i].name) {
+      instruction.opcode = i;
+    }
+  }
+  if (instruction.opcode < 0) {
+    return "unknown command '" + name + "'";
+  }
+  const ScriptOpcodeInfo& info = script_opcodes[instruction.opcode];
+
+  std::vector<std::string> args;
+  std::string inside = trimScriptText(text.substr(open + 1, close - open - 1));
+  size_t start = 0;
+  while (!inside.empty()) {
+    size_t comma = inside.find(',', start);
+    args.push_back(trimScriptText(inside.substr(start, comma == std::string::npos ? std::string::npos : comma - start)));
+    if (comma == std::string::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+
+  int arg_count = strlen(info.args);
+  if ((int)args.size() < info.required || (int)args.size() > arg_count) {
+    char message[96];
+    if (info.required == arg_count) {
+      snprintf(message, sizeof(message), "%s takes %d arguments", info.name, arg_count);
+    } else {
+      snprintf(message, sizeof(message), "%s takes %d to %d arguments", info.name, info.required, arg_count);
+    }
+    return message;
+  }
+  for (int i = 0; i < MAX_SCRIPT_ARGS; i++) {
+    instruction.args[i] = i < arg_count ? info.defaults[i] : 0;
+  }
+  for (size_t i = 0; i < args.size(); i++) {
+    std::string problem = parseScriptArg(info.args[i], args[i], script, instruction.args[i]);
+    if (problem != "") {
+      return "argument " + std::to_string(i + 1) + " of " + info.name + ": " + problem;
+    }
+  }
+  return "";
+}
+
+bool compileScript(const std::string& source, CompiledScript& script, std::string& error) {
+  script = CompiledScript();
+  CompiledRoutine* routine = 0;
+  int instruction_count = 0;
+  int line_number = 0;
+  size_t position = 0;
+
+  while (position <= source.size()) {
+    size_t end = source.find('\n', position);
+    std::string line = source.substr(position, end == std::string::npos ? std::string::npos : end - position);
+    position = end == std::string::npos ? source.size() + 1 : end + 1;
+    line_number++;
+
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) {
+      line.erase(comment);
+    }
+    line = trimScriptText(line);
+    if (!line.empty() && line[line.size() - 1] == ';') {
+      line = trimScriptText(line.substr(0, line.size() - 1));
+    }
+    if (line.empty()) {
+      continue;
+    }
+
+    std::string problem;
+    if (line.find(';') != std::string::npos) {
+      problem = "one command per line";
+    } else if (line.compare(0, 8, "routine ") == 0) {
+      std::string name = trimScriptText(line.substr(8));
+      if (name.empty() || name[name.size() - 1] != '{') {
+        problem = "expected routine <name> {";
+      } else if (routine) {
+        problem = "routine inside routine " + routine->name;
+      } else {
+        name = trimScriptText(name.substr(0, name.size() - 1));
+        if (!isScriptName(name)) {
+          problem = "routine names are up to 16 letters, digits or _";
+        }
+        for (size_t i = 0; i < script.routines.size(); i++) {
+          if (script.routines[i].name == name) {
+            problem = "routine " + name + " defined twice";
+          }
+        }
+        if (script.routines.size() >= MAX_SCRIPT_ROUTINES) {
+          problem = "more than " + std::to_string(MAX_SCRIPT_ROUTINES) + " routines";
+        }
+        if (problem.empty()) {
+          script.routines.push_back(CompiledRoutine());
+          routine = &script.routines.back();
+          routine->name = name;
+        }
+      }
+    } else if (line == "}") {
+      if (!routine) {
+        problem = "'}' outside a routine";
+      }
+      routine = 0;
+    } else if (!routine) {
+      problem = "commands go inside routine <name> { ... }";
+    } else {
+      CompiledInstruction instruction;
+      instruction.line = line_number;
+      problem = parseScriptCall(line, script, instruction);
+      if (problem.empty() && ++instruction_count > MAX_SCRIPT_INSTRUCTIONS) {
+        problem = "more than " + std::to_string(MAX_SCRIPT_INSTRUCTIONS) + " instructions";
+      }
+      if (problem.empty()) {
+        routine->steps.push_back(instruction);
+      }
+    }
+
+    if (!problem.empty()) {
+      error = "line " + std::to_string(line_number) + ": " + problem;
+      return false;
+    }
+  }
+  if (routine) {
+    error = "routine " + routine->name + " is missing its '}'";
+    return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+/*
+ * Appends a name padded to SCRIPT_NAME_SIZE bytes.
+ */
+void encodeScriptName(std::vector<unsigned char>& bytes, const std::string& name) {
+  for (int i = 0; i < SCRIPT_NAME_SIZE; i++) {
+    bytes.push_back(i < (int)name.size() ? name[i] : 0);
+  }
+}
+
+std::vector<unsigned char> encodeScript(const CompiledScript& script) {
+  std::vector<unsigned char> bytes;
+  const char* magic = "VAUT";
+  for (int i = 0; i < 4; i++) {
+    bytes.push_back(magic[i]);
+  }
+  bytes.push_back(SCRIPT_VERSION);
+  bytes.push_back(script.routines.size());
+  bytes.push_back(script.actions.size());
+  bytes.push_back(0);
+
+  for (size_t i = 0; i < script.actions.size(); i++) {
+    encodeScriptName(bytes, script.actions[i]);
+  }
+  for (size_t r = 0; r < script.routines.size(); r++) {
+    const CompiledRoutine& routine = script.routines[r];
+    encodeScriptName(bytes, routine.name);
+    bytes.push_back(routine.steps.size() & 0xff);
+    bytes.push_back(routine.steps.size() >> 8);
+    for (size_t i = 0; i < routine.steps.size(); i++) {
+      const CompiledInstruction& instruction = routine.steps[i];
+      bytes.push_back(instruction.opcode);
+      int arg_count = strlen(script_opcodes[instruction.opcode].args);
+      for (int a = 0; a < arg_count; a++) {
+        uint32_t bits;
+        memcpy(&bits, &instruction.args[a], sizeof(bits));
+        for (int b = 0; b < 4; b++) {
+          bytes.push_back((bits >> (8 * b)) & 0xff);
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+std::string describeInstruction(const CompiledScript& script, const CompiledInstruction& instruction) {
+  const ScriptOpcodeInfo& info = script_opcodes[instruction.opcode];
+  std::string text = std::string(info.name) + "(";
+  int arg_count = strlen(info.args);
+  for (int a = 0; a < arg_count; a++) {
+    float value = instruction.args[a];
+    char number[32];
+    snprintf(number, sizeof(number), "%g", value);
+    if (a > 0) {
+      text += ", ";
+    }
+    switch (info.args[a]) {
+    case 'a': text += script.actions[(int)value]; break;
+    case 'w': text += wall_names[(int)value]; break;
+    case 'b': text += value != 0 ? "true" : "false"; break;
+    default: text += number; break;
+    }
+  }
+  return text + ")";
+}
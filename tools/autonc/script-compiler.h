@@ -0,0 +1,56 @@
+#ifndef __SCRIPT_COMPILER__
+#define __SCRIPT_COMPILER__
+
+#include <string>
+#include <vector>
+
+#include "script-format.h"
+
+//declarations for the autonomous script compiler (host side).
+//
+//A script holds routines written like the C++ calls they run, one per line:
+//
+//  # red side, goal rush
+//  routine redGoalRush {
+//    setPose(-48, -60, 0)
+//    atDistance(20, intake_in)        # actions are names registered with addScriptAction
+//    driveTo(36, 1500, false)         # optional arguments default as in motor-control.h
+//    turnToAngle(90, 800)
+//    squareToWall(wall_right, 1, 1500)
+//    wait(250)
+//  }
+//
+//Numbers, true/false, wall_top/wall_right/wall_bottom/wall_left and action names are the
+//arguments; trailing semicolons are allowed.
+
+struct CompiledInstruction {
+  int opcode;
+  float args[MAX_SCRIPT_ARGS];
+  int line; // Source line, for reports
+};
+
+struct CompiledRoutine {
+  std::string name;
+  std::vector<CompiledInstruction> steps;
+};
+
+struct CompiledScript {
+  std::vector<std::string> actions; // Action names, in file order
+  std::vector<CompiledRoutine> routines;
+};
+
+/*
+ * compileScript
+ * Parses a script, filling in default arguments and checking argument kinds as loadScripts
+ * will on the robot (mechanism indexes are only checked there).
+ * Returns false with "line N: ..." in error on the first problem.
+ */
+bool compileScript(const std::string& source, CompiledScript& script, std::string& error);
+
+// The bytecode file for a compiled script (see script-format.h).
+std::vector<unsigned char> encodeScript(const CompiledScript& script);
+
+// One instruction as a call with all its arguments, e.g. driveTo(36, 1500, false, 12).
+std::string describeInstruction(const CompiledScript& script, const CompiledInstruction& instruction);
+
+#endif
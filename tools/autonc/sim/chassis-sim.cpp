@@ -0,0 +1,322 @@
+#include "vex.h"
+#include "motor-control.h"
+#include "chassis-sim.h"
+#include "path-planner.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <poll.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// ============================================================================
+// INTERNAL STATE (DO NOT CHANGE)
+// ============================================================================
+
+double sim_time_msec = 0;
+double sim_rotation_deg = 0;
+double sim_accel_g = 0;
+const char* sim_sd_dir = ".";
+
+double sim_gyro_bias_dps = 0;
+double sim_gyro_noise_deg = 0;
+double sim_tracker_scrub = 0;
+double sim_encoder_deg = 0;
+bool sim_wall_slip = false;
+bool sim_odometry = false;
+void (*sim_step_hook)() = 0;
+int sim_serial_fd = -1;
+
+// True pose and side speeds (inches, radians, inches per second)
+double sim_x = 0, sim_y = 0, sim_heading = 0;
+double sim_left_velocity = 0, sim_right_velocity = 0;
+// Forward speed of the robot itself, which is not the wheels' against a wall with sim_wall_slip (inches per second)
+double sim_body_velocity = 0;
+// Start of the inertial sensor's current acceleration period, and the speed then (msec, inches per second)
+double sim_accel_start_msec = 0, sim_accel_start_velocity = 0;
+bool sim_hit_wall = false;
+
+// Inertial sensor drift accumulated since resetSimulation (in degrees)
+double sim_gyro_drift_deg = 0;
+
+// x_pos/y_pos as last written, to notice the robot code resetting them
+double sim_written_x = 0, sim_written_y = 0;
+
+// Background tasks run by simRunTasks, each on its own stack; they take turns at their waits
+#define SIM_MAX_TASKS 4
+const size_t sim_task_stack_bytes = 256 * 1024;
+struct SimTask {
+  ucontext_t context;
+  void (*entry)();
+  char* stack;
+  double wake_msec; // Time the task's current wait ends
+};
+SimTask sim_tasks[SIM_MAX_TASKS];
+ucontext_t sim_scheduler_context;
+int sim_current_task = -1; // Task running now, -1 outside the tasks
+
+// Noise generator state (xorshift64)
+uint64_t sim_random_state = 1;
+
+// Longest physics step (in milliseconds); waits are split into steps this long
+const double sim_step_msec = 0.5;
+
+// Current limit and approximate winding resistance of a V5 motor (in amps, ohms)
+const double sim_current_limit = 2.5;
+const double sim_winding_ohms = 2;
+
+// Time the wheel speed takes to close most of the gap to the voltage's free speed (in seconds)
+const double sim_response_sec = 0.1;
+
+// Gravity (in inches per second squared)
+const double sim_gravity = 386.1;
+
+// Inertial sensor data period (in milliseconds)
+const double sim_accel_period_msec = 10;
+
+extern "C" int32_t vexSerialReadChar(uint32_t index) {
+  // Only what has already arrived, like the V5's receive buffer
+  pollfd serial = { sim_serial_fd, POLLIN, 0 };
+  unsigned char c;
+  if (sim_serial_fd < 0 || poll(&serial, 1, 0) <= 0 || read(sim_serial_fd, &c, 1) != 1) {
+    return -1;
+  }
+  return c;
+}
+
+/*
+ * Normally distributed noise with unit variance (Box-Muller).
+ */
+double simGaussian() {
+  double u[2];
+  for (int i = 0; i < 2; i++) {
+    sim_random_state ^= sim_random_state << 13;
+    sim_random_state ^= sim_random_state >> 7;
+    sim_random_state ^= sim_random_state << 17;
+    u[i] = ((sim_random_state >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+  }
+  return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+}
+
+/*
+ * Writes the inertial sensor reading for the true heading.
+ */
+void updateInertial() {
+  double noise = sim_gyro_noise_deg > 0 ? simGaussian() * sim_gyro_noise_deg : 0;
+  sim_rotation_deg = sim_heading * 180 / M_PI / inertial_scale + sim_gyro_drift_deg + noise;
+}
+
+void placeSimulation(double x, double y, double heading_deg) {
+  sim_x = x;
+  sim_y = y;
+  sim_heading = heading_deg * M_PI / 180;
+  sim_gyro_drift_deg = 0;
+  updateInertial();
+  x_pos = sim_written_x = x;
+  y_pos = sim_written_y = y;
+}
+
+void resetSimulation(double x, double y, double heading_deg) {
+  sim_time_msec = 0;
+  sim_left_velocity = sim_right_velocity = sim_body_velocity = 0;
+  sim_accel_g = 0;
+  sim_accel_start_msec = sim_accel_start_velocity = 0;
+  sim_hit_wall = false;
+  sim_random_state = 88172645463325252ull;
+  left_chassis.volts = right_chassis.volts = 0;
+  left_chassis.position_deg = right_chassis.position_deg = 0;
+  vertical_tracker.position_deg = right_vertical_tracker.position_deg = horizontal_tracker.position_deg = 0;
+  placeSimulation(x, y, heading_deg);
+  correct_angle = heading_deg;
+}
+
+bool simulationHitWall() {
+  return sim_hit_wall;
+}
+
+void simulationPose(double& x, double& y, double& heading_deg) {
+  x = sim_x;
+  y = sim_y;
+  heading_deg = sim_heading * 180 / M_PI;
+}
+
+/*
+ * Writes one side's speed and current to its motors.
+ */
+void setSideState(motor_base& group, motor& motor1, motor& motor2, motor& motor3, double velocity, double dt) {
+  group.position_deg += velocity * dt / wheel_distance_in * 360;
+  group.velocity_rpm = velocity / wheel_distance_in * 60;
+  // Current follows the voltage the back-EMF does not cancel
+  double free_voltage = velocity / max_chassis_velocity * 12;
+  double current = fmin(fabs(group.volts - free_voltage) / sim_winding_ohms, sim_current_limit);
+  motor1.current_amp = motor2.current_amp = motor3.current_amp = current;
+  motor1.velocity_rpm = motor2.velocity_rpm = motor3.velocity_rpm = group.velocity_rpm;
+}
+
+/*
+ * Turns a tracking wheel by the travel of its contact point along the wheel's axis.
+ * - travel_in: Travel of the tracking center along the axis (in inches).
+ * - offset_in: The wheel's distance from the tracking center (in inches, as in robot-config.cpp).
+ */
+void turnTracker(rotation& tracker, double travel_in, double offset_in, double delta_heading_rad, double diameter_in) {
+  double wheel_in = travel_in - offset_in * delta_heading_rad;
+  if (sim_tracker_scrub > 0) {
+    wheel_in *= 1 + simGaussian() * sim_tracker_scrub;
+  }
+  tracker.position_deg += wheel_in / (diameter_in * M_PI) * 360;
+}
+
+/*
+ * One physics step of the chassis model.
+ * - dt: Step length (in seconds).
+ */
+void simTick(double dt) {
+  if (sim_step_hook) {
+    sim_step_hook();
+  }
+  if (!sim_odometry && (x_pos != sim_written_x || y_pos != sim_written_y)) {
+    // The robot code moved its pose (setPose, squareToWall), the model follows
+    sim_x = x_pos;
+    sim_y = y_pos;
+  }
+
+  // First-order response towards the free speed of the commanded voltage
+  sim_left_velocity += (left_chassis.volts / 12 * max_chassis_velocity - sim_left_velocity) * dt / sim_response_sec;
+  sim_right_velocity += (right_chassis.volts / 12 * max_chassis_velocity - sim_right_velocity) * dt / sim_response_sec;
+
+  double forward = (sim_left_velocity + sim_right_velocity) / 2;
+  double turn_rate = (sim_left_velocity - sim_right_velocity) / distance_between_wheels;
+  double mid_heading = sim_heading + turn_rate * dt / 2;
+  double x = sim_x + forward * sin(mid_heading) * dt;
+  double y = sim_y + forward * cos(mid_heading) * dt;
+
+  // The bumpers stop at the walls
+  double limit = FIELD_SIZE_IN / 2.0 - fmax(front_bumper_in, back_bumper_in);
+  if (fabs(x) > limit || fabs(y) > limit) {
+    x = fmax(-limit, fmin(limit, x));
+    y = fmax(-limit, fmin(limit, y));
+    if (!sim_wall_slip) {
+      sim_left_velocity = sim_right_velocity = 0;
+    }
+    forward = 0;
+    sim_hit_wall = true;
+  }
+
+  // The tracking wheels roll with the center's travel along and across the heading
+  double forward_travel = (x - sim_x) * sin(mid_heading) + (y - sim_y) * cos(mid_heading);
+  double right_travel = (x - sim_x) * cos(mid_heading) - (y - sim_y) * sin(mid_heading);
+  double delta_heading = turn_rate * dt;
+  turnTracker(vertical_tracker, forward_travel, vertical_tracker_dist_from_center, delta_heading, vertical_tracker_diameter);
+  turnTracker(right_vertical_tracker, forward_travel, right_vertical_tracker_dist_from_center, delta_heading, right_vertical_tracker_diameter);
+  turnTracker(horizontal_tracker, right_travel, horizontal_tracker_dist_from_center, delta_heading, horizontal_tracker_diameter);
+
+  sim_x = x;
+  sim_y = y;
+  sim_heading += delta_heading;
+  sim_gyro_drift_deg += sim_gyro_bias_dps * dt;
+  updateInertial();
+
+  // The inertial sensor reports the acceleration averaged over each period, like a 100 Hz
+  // sensor; an impact shows up as one large reading instead of a spike between reads
+  sim_body_velocity = forward;
+  double now_msec = sim_time_msec + dt * 1000;
+  if (now_msec - sim_accel_start_msec >= sim_accel_period_msec - 1e-9) {
+    sim_accel_g = (forward - sim_accel_start_velocity) / ((now_msec - sim_accel_start_msec) / 1000) / sim_gravity;
+    sim_accel_start_msec = now_msec;
+    sim_accel_start_velocity = forward;
+  }
+  setSideState(left_chassis, left_chassis1, left_chassis2, left_chassis3, sim_left_velocity, dt);
+  setSideState(right_chassis, right_chassis1, right_chassis2, right_chassis3, sim_right_velocity, dt);
+  if (!sim_odometry) {
+    x_pos = sim_written_x = sim_x;
+    y_pos = sim_written_y = sim_y;
+  }
+}
+
+void simSkillsDrive() {
+  double t = sim_time_msec / 1000;
+  double turn = fmod(t, 4.8) < 2.4 ? 4 : -4;
+  if (hypot(sim_x, sim_y) > 36) {
+    // Steer back toward the middle of the field
+    double to_center_rad = remainder(atan2(-sim_x, -sim_y) - sim_heading, 2 * M_PI);
+    turn = to_center_rad > 0 ? 4 : -4;
+  }
+  turn += 2 * sin(2 * M_PI * 1.5 * t);
+  left_chassis.volts = 6 + turn;
+  right_chassis.volts = 6 - turn;
+}
+
+/*
+ * Runs the physics until sim_time_msec reaches end_time.
+ */
+void simAdvance(double end_time) {
+  while (sim_time_msec < end_time - 1e-9) {
+    double step_msec = fmin(sim_step_msec, end_time - sim_time_msec);
+    simTick(step_msec / 1000);
+    sim_time_msec += step_msec;
+  }
+}
+
+void simWait(double time_msec) {
+  // Even a zero wait lets one step pass, so polling loops make progress
+  double end_time = sim_time_msec + fmax(time_msec, sim_step_msec);
+  if (sim_current_task < 0) {
+    simAdvance(end_time);
+    return;
+  }
+  // A task hands the time over to simRunTasks, which wakes it at end_time
+  SimTask& task = sim_tasks[sim_current_task];
+  task.wake_msec = end_time;
+  swapcontext(&task.context, &sim_scheduler_context);
+}
+
+void simTaskEntry() {
+  sim_tasks[sim_current_task].entry();
+  // Tasks are endless loops; one that returns just stops being woken
+  sim_tasks[sim_current_task].wake_msec = 1e300;
+  swapcontext(&sim_tasks[sim_current_task].context, &sim_scheduler_context);
+}
+
+void simRunTasks(void (*tasks[])(), int count, double time_msec) {
+  double end_time = sim_time_msec + time_msec;
+  count = count < SIM_MAX_TASKS ? count : SIM_MAX_TASKS;
+  for (int i = 0; i < count; i++) {
+    SimTask& task = sim_tasks[i];
+    task.entry = tasks[i];
+    task.stack = (char*)malloc(sim_task_stack_bytes);
+    task.wake_msec = sim_time_msec;
+    getcontext(&task.context);
+    task.context.uc_stack.ss_sp = task.stack;
+    task.context.uc_stack.ss_size = sim_task_stack_bytes;
+    task.context.uc_link = 0;
+    makecontext(&task.context, simTaskEntry, 0);
+  }
+
+  while (true) {
+    // Every task whose wait is over runs, in order, until its next wait
+    for (int i = 0; i < count; i++) {
+      if (sim_tasks[i].wake_msec <= sim_time_msec + 1e-9) {
+        sim_current_task = i;
+        swapcontext(&sim_scheduler_context, &sim_tasks[i].context);
+        sim_current_task = -1;
+      }
+    }
+    // The tasks have handled the end time: they stop at the wait they are in
+    if (sim_time_msec >= end_time - 1e-9) {
+      break;
+    }
+    double next_wake = end_time;
+    for (int i = 0; i < count; i++) {
+      next_wake = fmin(next_wake, sim_tasks[i].wake_msec);
+    }
+    simAdvance(next_wake);
+  }
+
+  for (int i = 0; i < count; i++) {
+    free(sim_tasks[i].stack);
+  }
+}
+
+void simRunTask(void (*task)(), double time_msec) {
+  simRunTasks(&task, 1, time_msec);
+}
@@ -0,0 +1,53 @@
+#ifndef __CHASSIS_SIM__
+#define __CHASSIS_SIM__
+
+//declarations for the chassis model behind the simulated V5 API.
+//Each side's wheel speed follows its voltage with a first-order lag towards the free speed
+//(max_chassis_velocity at 12 volts); the field walls stop the robot. The tracking wheels
+//turn with the tracking center's motion at their configured offsets.
+
+// Puts the robot at rest at a field pose (inches, degrees) and restarts the clock.
+void resetSimulation(double x, double y, double heading_deg);
+
+// Moves the robot without restarting the clock (setPose in a routine).
+void placeSimulation(double x, double y, double heading_deg);
+
+// Whether the robot touched a field wall since the last resetSimulation.
+bool simulationHitWall();
+
+// True pose of the tracking center (inches, degrees clockwise from +y).
+void simulationPose(double& x, double& y, double& heading_deg);
+
+// Sensor errors, 0 (exact sensors) unless a test sets them. resetSimulation restarts the
+// noise sequence, so runs with the same settings see the same noise.
+extern double sim_gyro_bias_dps;  // Inertial sensor drift (in degrees per second)
+extern double sim_gyro_noise_deg; // Inertial sensor reading noise (standard deviation, in degrees)
+extern double sim_tracker_scrub;  // Tracking wheel travel error (standard deviation, fraction of each step's travel)
+// sim_encoder_deg (v5_vcs.h) sets the motor encoder resolution, 1.2 degrees on a V5 600 rpm motor.
+
+// When true the drive wheels keep spinning when the robot is pushed against a wall, as on a
+// light robot, instead of stalling with it.
+extern bool sim_wall_slip;
+
+// When true the robot's odometry (a tracker run with simRunTask) owns x_pos/y_pos and the
+// model stops writing the true pose there.
+extern bool sim_odometry;
+
+// Called before every physics step, to script the drive voltages or stand in for a sensor.
+extern void (*sim_step_hook)();
+
+// USB serial input: vexSerialReadChar reads from this file descriptor (one side of a pty in
+// the tests) without blocking. -1, the default, is a port nothing is sent to.
+extern int sim_serial_fd;
+
+// Step hook for the odometry benchmarks and tests: figure eights with fast weaving on top,
+// so the robot keeps turning while it drives, kept within 36 inches of the field center.
+void simSkillsDrive();
+
+// Runs endless background tasks (an odometry tracker, headingLoop, localizationLoop, ...) for
+// time_msec of simulated time. The tasks take turns at their waits, as the V5's cooperative
+// threads do, and the model steps until the next task wakes; at the end they are left in their waits.
+void simRunTasks(void (*tasks[])(), int count, double time_msec);
+void simRunTask(void (*task)(), double time_msec);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __SIM_V5__
+#define __SIM_V5__
+
+//Host stand-in for the VEX SDK's v5.h, used to build the robot sources into tools/autonc.
+//Only what the robot code uses is provided.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PORT1 0
+#define PORT2 1
+#define PORT3 2
+#define PORT4 3
+#define PORT5 4
+#define PORT6 5
+#define PORT7 6
+#define PORT8 7
+#define PORT9 8
+#define PORT10 9
+#define PORT11 10
+#define PORT12 11
+#define PORT13 12
+#define PORT14 13
+#define PORT15 14
+#define PORT16 15
+#define PORT17 16
+#define PORT18 17
+#define PORT19 18
+#define PORT20 19
+#define PORT21 20
+
+// USB serial input, -1 when there is none (always, in the simulator).
+extern "C" int32_t vexSerialReadChar(uint32_t index);
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef __SIM_V5_VCS__
+#define __SIM_V5_VCS__
+
+//Host stand-in for the VEX SDK's v5_vcs.h. Devices read and write the chassis model in
+//chassis-sim.cpp; time only passes in wait(), in physics steps of at most 0.5 msec.
+//Threads are not run: the robot code's background tasks (odometry, triggers, mechanisms)
+//are replaced by the model writing x_pos/y_pos directly, or run by the tests and benchmarks
+//with simRunTasks.
+
+#include <cmath>
+#include <cstdio>
+
+// Simulated time and the chassis model (chassis-sim.cpp)
+extern double sim_time_msec;
+extern double sim_rotation_deg; // Inertial sensor rotation (in degrees)
+extern double sim_accel_g;      // Inertial sensor forward acceleration (in g)
+extern double sim_encoder_deg;  // Motor encoder resolution (in degrees), 0 for exact positions
+extern const char* sim_sd_dir;  // Directory standing in for the SD card
+void simWait(double time_msec);
+
+namespace vex {
+enum brakeType { coast, brake, hold };
+enum directionType { fwd, reverse, forward = fwd };
+enum class voltageUnits { volt, mV };
+static const voltageUnits volt = voltageUnits::volt;
+enum rotationUnits { deg, rev, raw, degrees = deg, turns = rev };
+enum timeUnits { sec, msec, seconds = sec };
+enum velocityUnits { pct, rpm, dps };
+enum percentUnits { percent };
+enum distanceUnits { mm, inches, cm };
+enum currentUnits { amp };
+enum temperatureUnits { celsius, fahrenheit };
+enum powerUnits { watt };
+enum torqueUnits { Nm, InLb };
+enum axisType { xaxis, yaxis, zaxis };
+enum gearSetting { ratio36_1, ratio18_1, ratio6_1 };
+enum controllerType { primary, partner };
+enum class ledState { off, on };
+enum fontType { mono12, mono15, mono20, prop20 };
+
+struct color {
+  int value;
+  color(int new_value = 0) : value(new_value) {}
+};
+static const color black(0), white(1), red(2), green(3), blue(4), yellow(5), orange(6), purple(7), cyan(8), transparent(9);
+
+struct triport {
+  struct port { int index; };
+  port A, B, C, D, E, F, G, H;
+};
+
+struct screen_t {
+  void clearScreen(color = black) {}
+  void clearLine(int = 0) {}
+  void setPenColor(color) {}
+  void setFillColor(color) {}
+  void setFont(fontType) {}
+  void drawLine(double, double, double, double) {}
+  void drawRectangle(int, int, int, int) {}
+  void drawCircle(int, int, int) {}
+  void setCursor(int, int) {}
+  void newLine() {}
+  template <class... Args> void print(Args...) {}
+  template <class... Args> void printAt(int, int, Args...) {}
+};
+
+struct battery_t {
+  double voltage_v = 12.8; // Set by a test to run on a drained battery
+  double voltage(voltageUnits = voltageUnits::volt) { return voltage_v; }
+  double current(currentUnits = amp) { return 0; }
+  int capacity(percentUnits = percent) { return 100; }
+  double temperature(percentUnits = percent) { return 0; }
+};
+
+// Files are read from and written to sim_sd_dir; absolute paths are used as they are.
+struct sdcard_t {
+  bool isInserted() { return true; }
+  int32_t loadfile(const char* name, uint8_t* buffer, int32_t length) {
+    FILE* file = openFile(name, "rb");
+    if (!file) return 0;
+    int32_t read = fread(buffer, 1, length, file);
+    fclose(file);
+    return read;
+  }
+  int32_t savefile(const char* name, uint8_t* buffer, int32_t length) {
+    FILE* file = openFile(name, "wb");
+    if (!file) return 0;
+    int32_t written = fwrite(buffer, 1, length, file);
+    fclose(file);
+    return written;
+  }
+  int32_t appendfile(const char*, uint8_t*, int32_t length) { return length; }
+  int32_t size(const char*) { return 0; }
+  bool exists(const char*) { return false; }
+
+  FILE* openFile(const char* name, const char* mode) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s%s%s", name[0] == '/' ? "" : sim_sd_dir, name[0] == '/' ? "" : "/", name);
+    return fopen(path, mode);
+  }
+};
+
+class brain {
+ public:
+  screen_t Screen;
+  battery_t Battery;
+  triport ThreeWirePort;
+  sdcard_t SDcard;
+  double timer(timeUnits units) { return units == msec ? sim_time_msec : sim_time_msec / 1000; }
+  void resetTimer() {}
+};
+
+// Motors hold the commanded voltage, clipped to +/-12 V as the V5 firmware does; the chassis
+// model fills in position, velocity and current.
+struct motor_base {
+  double volts = 0, position_deg = 0, velocity_rpm = 0, current_amp = 0;
+  void spin(directionType) {}
+  void spin(directionType direction, double voltage, voltageUnits) { volts = fmax(fmin(direction == fwd ? voltage : -voltage, 12), -12); }
+  void spin(directionType, double, velocityUnits) {}
+  void stop() { volts = 0; }
+  void stop(brakeType) { volts = 0; }
+  void setStopping(brakeType) {}
+  double position(rotationUnits) { return sim_encoder_deg > 0 ? floor(position_deg / sim_encoder_deg) * sim_encoder_deg : position_deg; }
+  void setPosition(double new_position, rotationUnits) { position_deg = new_position; }
+  void resetPosition() { position_deg = 0; }
+  double velocity(velocityUnits) { return velocity_rpm; }
+  double current(currentUnits = amp) { return current_amp; }
+  double current(percentUnits) { return current_amp / 2.5 * 100; }
+  double temperature(temperatureUnits = celsius) { return 30; }
+  double temperature(percentUnits) { return 0; }
+  double power(powerUnits = watt) { return fabs(volts * current_amp); }
+  double torque(torqueUnits = Nm) { return 0; }
+  double voltage(voltageUnits = voltageUnits::volt) { return volts; }
+  double efficiency(percentUnits = percent) { return 0; }
+  void setMaxTorque(double, percentUnits) {}
+  void setMaxTorque(double, currentUnits) {}
+  bool installed() { return true; }
+};
+
+class motor : public motor_base {
+ public:
+  motor(int, gearSetting, bool) {}
+  motor(int, bool = false) {}
+};
+
+class motor_group : public motor_base {
+ public:
+  template <class... Motors> motor_group(Motors&...) {}
+  int count() { return 3; }
+};
+
+class inertial {
+ public:
+  inertial(int) {}
+  void calibrate() {}
+  bool isCalibrating() { return false; }
+  double rotation(rotationUnits = deg) { return sim_rotation_deg; }
+  double heading(rotationUnits = deg) { return fmod(fmod(sim_rotation_deg, 360) + 360, 360); }
+  void setRotation(double, rotationUnits) {}
+  void setHeading(double, rotationUnits) {}
+  void resetRotation() {}
+  double acceleration(axisType axis) { return axis == yaxis ? sim_accel_g : 0; }
+  double gyroRate(axisType, velocityUnits) { return 0; }
+};
+
+// Tracking wheels; the model turns the three in robot-config.cpp.
+class rotation {
+ public:
+  rotation(int, bool = false) {}
+  double position_deg = 0;
+  double position(rotationUnits) { return position_deg; }
+  void setPosition(double new_position, rotationUnits) { position_deg = new_position; }
+  void resetPosition() { position_deg = 0; }
+  double velocity(velocityUnits) { return 0; }
+};
+
+// Sensors the model does not simulate read as idle.
+
+class distance {
+ public:
+  distance(int) {}
+  double distance_mm = 0; // Set by a test or step hook; 0 = nothing in range
+  double objectDistance(distanceUnits units) { return units == mm ? distance_mm : units == cm ? distance_mm / 10 : distance_mm / 25.4; }
+  bool isObjectDetected() { return distance_mm > 0; }
+  double objectVelocity() { return 0; }
+};
+
+class optical {
+ public:
+  optical(int) {}
+  double hue() { return 0; }
+  double brightness() { return 0; }
+  bool isNearObject() { return false; }
+  void setLight(ledState) {}
+  void setLightPower(double, percentUnits = percent) {}
+};
+
+class digital_out {
+ public:
+  digital_out(triport::port&) {}
+  void set(bool new_value) { state = new_value; }
+  int value() { return state; }
+  bool state = false;
+};
+
+class digital_in {
+ public:
+  digital_in(triport::port&) {}
+  int value() { return 0; }
+};
+
+struct ctl_button {
+  bool pressing() { return false; }
+  void pressed(void (*)()) {}
+  void released(void (*)()) {}
+};
+struct ctl_axis {
+  int value() { return 0; }
+  int position() { return 0; }
+};
+struct ctl_screen {
+  void clearScreen() {}
+  void clearLine(int) {}
+  void setCursor(int, int) {}
+  template <class... Args> void print(Args...) {}
+  void newLine() {}
+};
+
+class controller {
+ public:
+  controller(controllerType = primary) {}
+  ctl_axis Axis1, Axis2, Axis3, Axis4;
+  ctl_button ButtonL1, ButtonL2, ButtonR1, ButtonR2, ButtonA, ButtonB, ButtonX, ButtonY;
+  ctl_button ButtonUp, ButtonDown, ButtonLeft, ButtonRight;
+  ctl_screen Screen;
+  void rumble(const char*) {}
+};
+
+class thread {
+ public:
+  thread() {}
+  thread(void (*)()) {}
+  thread(int (*)()) {}
+  thread(int (*)(void*), void*) {}
+  void interrupt() {}
+  void join() {}
+  void detach() {}
+  bool joinable() { return false; }
+  static void setPriority(int) {}
+};
+
+class mutex {
+ public:
+  void lock() {}
+  void unlock() {}
+  bool try_lock() { return true; }
+};
+
+namespace this_thread {
+inline void sleep_for(uint32_t time_msec) { simWait(time_msec); }
+inline void yield() {}
+}
+
+class competition {
+ public:
+  void autonomous(void (*)()) {}
+  void drivercontrol(void (*)()) {}
+  bool isAutonomous() { return true; }
+  bool isEnabled() { return true; }
+};
+
+namespace vision {
+struct signature {};
+struct code {};
+}
+
+inline void wait(double time, timeUnits units) { simWait(units == msec ? time : time * 1000); }
+inline uint32_t timer_system() { return (uint32_t)sim_time_msec; }
+}
+
+using namespace vex;
+
+#endif
@@ -0,0 +1,39 @@
+// Battery compensation of the chassis outputs: on a drained battery both sides are
+// rescaled by the same factor, and scaled down together when that would ask for more
+// than 12 volts, so the turn ratio is kept.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "battery.h"
+#include "tests/check.h"
+
+int main() {
+  Brain.Battery.voltage_v = 11.2;
+  double scale = battery_reference_voltage / 11.2;
+  CHECK_NEAR(getBatteryScale(), scale, 1e-9);
+
+  // Within 12 volts: both sides rescaled
+  driveChassis(6, -3);
+  CHECK_NEAR(left_chassis.volts, 6 * scale, 1e-9);
+  CHECK_NEAR(right_chassis.volts, -3 * scale, 1e-9);
+
+  // Past 12 volts: the faster side gets 12 and the slower keeps its share
+  driveChassis(12, 6);
+  CHECK_NEAR(left_chassis.volts, 12, 1e-9);
+  CHECK_NEAR(right_chassis.volts, 6, 1e-9);
+  driveChassis(-4, 11);
+  CHECK_NEAR(left_chassis.volts / right_chassis.volts, -4.0 / 11, 1e-9);
+  CHECK_NEAR(right_chassis.volts, 12, 1e-9);
+
+  // A single output is clipped on its own
+  CHECK_NEAR(compensateVoltage(11), 12, 1e-9);
+
+  // Off: outputs pass through
+  battery_compensation = false;
+  CHECK_NEAR(getBatteryScale(), 1, 1e-9);
+  driveChassis(6, -3);
+  CHECK_NEAR(left_chassis.volts, 6, 1e-9);
+  CHECK_NEAR(right_chassis.volts, -3, 1e-9);
+
+  return checkResult("battery");
+}
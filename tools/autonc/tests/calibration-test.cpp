@@ -0,0 +1,123 @@
+// Geometry calibration fit: synthetic straight runs and spins generated from a known
+// geometry are fed to addStraightRun/addSpinStep, and solveGeometry has to recover it,
+// exactly from exact travel and closely from travel with encoder noise and wheel scrub.
+
+#include "vex.h"
+#include "calibration.h"
+#include "tests/check.h"
+
+#include <stdint.h>
+
+// The robot as built, different from the values in robot-config.cpp
+const GeometryCalibration truth = { 7.62, 11.85, 2.03, 1.99, -0.4, 2.5, 5.3 };
+
+uint64_t noise_bits = 88172645463325252ull;
+
+// xorshift64, uniform in [-1, 1)
+double noiseUniform() {
+  noise_bits ^= noise_bits << 13;
+  noise_bits ^= noise_bits >> 7;
+  noise_bits ^= noise_bits << 17;
+  return (noise_bits >> 11) * (2.0 / 9007199254740992.0) - 1;
+}
+
+/*
+ * Degrees a wheel of the given diameter turns over a distance, with a relative error of up to noise.
+ */
+double wheelDegrees(double travel_in, double diameter_in, double noise) {
+  return travel_in / (diameter_in * M_PI) * 360 * (1 + noise * noiseUniform());
+}
+
+/*
+ * Sensor travel of a straight drive of travel_in (in inches).
+ */
+CalibrationStep straightRun(double travel_in, double noise) {
+  double drive_diameter = truth.wheel_distance_in / M_PI;
+  CalibrationStep run = { 0, wheelDegrees(travel_in, drive_diameter, noise), wheelDegrees(travel_in, drive_diameter, noise),
+                          wheelDegrees(travel_in, truth.vertical_tracker_diameter, noise), 0,
+                          wheelDegrees(travel_in, truth.right_vertical_tracker_diameter, noise) };
+  return run;
+}
+
+/*
+ * Sensor travel of a spin in place by delta_heading_rad (clockwise positive). Each wheel
+ * moves back by its offset to the right times the heading change.
+ */
+CalibrationStep spinStep(double delta_heading_rad, double noise) {
+  double drive_diameter = truth.wheel_distance_in / M_PI;
+  double half_width = truth.distance_between_wheels / 2;
+  CalibrationStep step = { delta_heading_rad,
+                           wheelDegrees(half_width * delta_heading_rad, drive_diameter, noise),
+                           wheelDegrees(-half_width * delta_heading_rad, drive_diameter, noise),
+                           wheelDegrees(-truth.vertical_tracker_dist_from_center * delta_heading_rad, truth.vertical_tracker_diameter, noise),
+                           wheelDegrees(-truth.horizontal_tracker_dist_from_center * delta_heading_rad, horizontal_tracker_diameter, noise),
+                           wheelDegrees(-truth.right_vertical_tracker_dist_from_center * delta_heading_rad, truth.right_vertical_tracker_diameter, noise) };
+  return step;
+}
+
+/*
+ * Fits a calibration run: straight runs each way between walls wall_gap_in apart, then
+ * spins of rotations turns each way in 10 msec steps. Returns solveGeometry's result.
+ */
+bool fitRun(GeometryCalibration& geometry, int straight_runs, int rotations, double noise) {
+  const double wall_gap_in = 96;
+  GeometryFit fit;
+  clearGeometryFit(fit);
+  for (int i = 0; i < straight_runs; i++) {
+    addStraightRun(fit, wall_gap_in, straightRun(wall_gap_in, noise));
+    addStraightRun(fit, -wall_gap_in, straightRun(-wall_gap_in, noise));
+  }
+  for (int direction = 1; direction >= -1; direction -= 2) {
+    int steps = rotations * 300;
+    for (int i = 0; i < steps; i++) {
+      addSpinStep(fit, spinStep(direction * 2 * M_PI / 300 * (1 + 0.3 * noiseUniform()), noise));
+    }
+  }
+  geometry = currentGeometry();
+  return solveGeometry(fit, geometry);
+}
+
+/*
+ * Checks the fit against the truth.
+ * - diameter_tolerance: Relative error allowed in the wheel and tracker diameters.
+ * - spin_tolerance_in: Error allowed in the drive width and tracker offsets (in inches).
+ */
+void checkGeometry(const GeometryCalibration& geometry, double diameter_tolerance, double spin_tolerance_in) {
+  CHECK_NEAR(geometry.wheel_distance_in, truth.wheel_distance_in, diameter_tolerance * truth.wheel_distance_in);
+  CHECK_NEAR(geometry.vertical_tracker_diameter, truth.vertical_tracker_diameter, diameter_tolerance * truth.vertical_tracker_diameter);
+  CHECK_NEAR(geometry.right_vertical_tracker_diameter, truth.right_vertical_tracker_diameter, diameter_tolerance * truth.right_vertical_tracker_diameter);
+  CHECK_NEAR(geometry.distance_between_wheels, truth.distance_between_wheels, spin_tolerance_in);
+  CHECK_NEAR(geometry.vertical_tracker_dist_from_center, truth.vertical_tracker_dist_from_center, spin_tolerance_in);
+  CHECK_NEAR(geometry.horizontal_tracker_dist_from_center, truth.horizontal_tracker_dist_from_center, spin_tolerance_in);
+  CHECK_NEAR(geometry.right_vertical_tracker_dist_from_center, truth.right_vertical_tracker_dist_from_center, spin_tolerance_in);
+}
+
+int main() {
+  using_vertical_tracker = using_horizontal_tracker = using_parallel_trackers = true;
+  GeometryCalibration geometry;
+
+  // Exact travel: the geometry comes back exactly
+  CHECK(fitRun(geometry, 2, 3, 0));
+  checkGeometry(geometry, 1e-9, 1e-9);
+
+  // Encoder noise and scrub of up to 1% per reading. The four straight runs each put their
+  // whole error into the diameters; the thousands of spin steps average theirs out.
+  CHECK(fitRun(geometry, 2, 3, 0.01));
+  checkGeometry(geometry, 0.01, 0.03);
+  printf("calibration: with 1%% noise, drive width %.4f (true %.4f), vertical offset %.4f (true %.4f)\n",
+         geometry.distance_between_wheels, truth.distance_between_wheels,
+         geometry.vertical_tracker_dist_from_center, truth.vertical_tracker_dist_from_center);
+
+  // No straight runs: the diameters keep their configured values
+  CHECK(fitRun(geometry, 0, 3, 0));
+  CHECK_NEAR(geometry.wheel_distance_in, wheel_distance_in, 1e-12);
+  CHECK_NEAR(geometry.vertical_tracker_diameter, vertical_tracker_diameter, 1e-12);
+
+  // Without a spin there is nothing to solve
+  GeometryFit empty;
+  clearGeometryFit(empty);
+  addStraightRun(empty, 96, straightRun(96, 0));
+  CHECK(!solveGeometry(empty, geometry));
+
+  return checkResult("calibration");
+}
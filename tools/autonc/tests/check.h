@@ -0,0 +1,41 @@
+#ifndef __CHECK__
+#define __CHECK__
+
+//Checks for the host tests (make test). A failed check prints its line and the test keeps
+//going; checkResult() prints the summary and is the test's exit status.
+//
+// Example:
+//   CHECK(planPath(...) == 0);
+//   CHECK_NEAR(x_pos, 24, 0.5);
+//   return checkResult("path-planner");
+
+#include <cmath>
+#include <cstdio>
+
+static int check_count = 0, check_failures = 0;
+
+#define CHECK(condition) checkTrue((condition), #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(value, expected, tolerance) checkNear((value), (expected), (tolerance), #value, __FILE__, __LINE__)
+
+inline void checkTrue(bool passed, const char* text, const char* file, int line) {
+  check_count++;
+  if (!passed) {
+    check_failures++;
+    printf("%s:%d: failed: %s\n", file, line, text);
+  }
+}
+
+inline void checkNear(double value, double expected, double tolerance, const char* text, const char* file, int line) {
+  check_count++;
+  if (!(fabs(value - expected) <= tolerance)) {
+    check_failures++;
+    printf("%s:%d: failed: %s = %g, expected %g +/- %g\n", file, line, text, value, expected, tolerance);
+  }
+}
+
+inline int checkResult(const char* name) {
+  printf("%s: %d checks, %d failed\n", name, check_count, check_failures);
+  return check_failures == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,74 @@
+// Accuracy of the polynomial trig kernels (fast-math.h) against libm, over the ranges
+// odometry and the motion primitives use, checked against the bounds in fast-math.h.
+
+#include "fast-math.h"
+#include "tests/check.h"
+
+#include <stdint.h>
+
+uint64_t random_bits = 88172645463325252ull;
+
+// xorshift64, uniform in [low, high)
+double randomIn(double low, double high) {
+  random_bits ^= random_bits << 13;
+  random_bits ^= random_bits >> 7;
+  random_bits ^= random_bits << 17;
+  return low + (high - low) * (random_bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+const int samples = 2000000;
+
+int main() {
+  double sin_error = 0, cos_error = 0, sinf_error = 0, cosf_error = 0;
+  for (int i = 0; i < samples; i++) {
+    double x = randomIn(-50, 50);
+    float xf = (float)x;
+    sin_error = fmax(sin_error, fabs(fastSin(x) - sin(x)));
+    cos_error = fmax(cos_error, fabs(fastCos(x) - cos(x)));
+    sinf_error = fmax(sinf_error, fabs(fastSin(xf) - sin((double)xf)));
+    cosf_error = fmax(cosf_error, fabs(fastCos(xf) - cos((double)xf)));
+  }
+  printf("sin/cos max error: double %.2g/%.2g, float %.2g/%.2g\n", sin_error, cos_error, sinf_error, cosf_error);
+  CHECK(sin_error < 1e-11);
+  CHECK(cos_error < 1e-11);
+  CHECK(sinf_error < 4e-6);
+  CHECK(cosf_error < 4e-6);
+
+  // Ratios from tiny to huge, in every quadrant
+  double atan2_error = 0, atan2f_error = 0;
+  for (int i = 0; i < samples; i++) {
+    double y = randomIn(-1, 1) * pow(10, randomIn(-3, 3));
+    double x = randomIn(-1, 1) * pow(10, randomIn(-3, 3));
+    float yf = (float)y, xf = (float)x;
+    atan2_error = fmax(atan2_error, fabs(fastAtan2(y, x) - atan2(y, x)));
+    atan2f_error = fmax(atan2f_error, fabs(fastAtan2(yf, xf) - atan2((double)yf, (double)xf)));
+  }
+  printf("atan2 max error: double %.2g, float %.2g\n", atan2_error, atan2f_error);
+  CHECK(atan2_error < 5e-10);
+  CHECK(atan2f_error < 1e-5);
+
+  // Axes and the origin, where the octant folding branches
+  CHECK(fastAtan2(0.0, 0.0) == 0);
+  CHECK(fastAtan2(0.0f, 0.0f) == 0);
+  CHECK_NEAR(fastAtan2(1.0, 0.0), M_PI / 2, 1e-12);
+  CHECK_NEAR(fastAtan2(-1.0, 0.0), -M_PI / 2, 1e-12);
+  CHECK_NEAR(fastAtan2(0.0, -1.0), M_PI, 1e-12);
+  CHECK_NEAR(fastAtan2(0.0, 1.0), 0, 1e-12);
+  CHECK_NEAR(fastAtan2(1.0, 1.0), M_PI / 4, 1e-12);
+  CHECK_NEAR(fastAtan2(-1.0, -1.0), -3 * M_PI / 4, 1e-12);
+
+  // Field-sized coordinates
+  double hypot_error = 0, hypotf_error = 0;
+  for (int i = 0; i < samples; i++) {
+    double x = randomIn(-200, 200), y = randomIn(-200, 200);
+    float xf = (float)x, yf = (float)y;
+    double exact = hypot(x, y), exact_f = hypot((double)xf, (double)yf);
+    hypot_error = fmax(hypot_error, fabs(fastHypot(x, y) - exact) / exact);
+    hypotf_error = fmax(hypotf_error, fabs(fastHypot(xf, yf) - exact_f) / exact_f);
+  }
+  printf("hypot max relative error: double %.2g, float %.2g\n", hypot_error, hypotf_error);
+  CHECK(hypot_error < 4e-16);
+  CHECK(hypotf_error < 2e-7);
+
+  return checkResult("fast-math");
+}
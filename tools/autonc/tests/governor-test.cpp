@@ -0,0 +1,53 @@
+// Thermal governor in driveChassis and the driving slew: the cap holds on the voltage the
+// motors get after battery compensation, and only acceleration is slowed, not braking.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+// Output fraction from governorLoop (governor.cpp), set directly instead of heating the motors
+extern double governor_scale;
+
+// Largest rise and fall of the left side's output between control ticks (in volts)
+double prev_volts = 0, largest_rise = 0, largest_fall = 0;
+
+void recordSlew() {
+  if (!is_turning) {
+    return;
+  }
+  double change = left_chassis.volts - prev_volts;
+  largest_rise = fmax(largest_rise, change);
+  largest_fall = fmax(largest_fall, -change);
+  prev_volts = left_chassis.volts;
+}
+
+int main() {
+  // Hot motors on a drained battery: the motors get no more than the governed 7.2 volts
+  governor_scale = 0.6;
+  Brain.Battery.voltage_v = 11.2;
+  driveChassis(12, 6);
+  CHECK_NEAR(left_chassis.volts, 7.2, 1e-9);
+  CHECK_NEAR(right_chassis.volts, 3.6, 1e-9);
+  driveChassis(-3, 9);
+  CHECK_NEAR(right_chassis.volts, 7.2, 1e-9);
+  CHECK_NEAR(left_chassis.volts / right_chassis.volts, -3.0 / 9, 1e-9);
+  // Below the cap the battery compensation is untouched
+  driveChassis(4, 2);
+  CHECK_NEAR(left_chassis.volts, 4 * 12.8 / 11.2, 1e-9);
+
+  // Slew of 1 volt per tick each way: a hot robot speeds up at 0.6 volts per tick but
+  // still brakes at the full rate (battery compensation off, so the outputs reach the motors)
+  battery_compensation = false;
+  max_slew_accel_fwd = max_slew_decel_fwd = 1;
+  resetSimulation(0, 0, 0);
+  sim_step_hook = recordSlew;
+  driveTo(24, 3000);
+  sim_step_hook = 0;
+  CHECK(!last_motion.timed_out);
+  CHECK(largest_rise <= 0.6 + 1e-9);
+  CHECK(largest_fall > 0.99);
+  printf("governor: at 0.6 the output rose by up to %.2f V and fell by up to %.2f V per tick\n", largest_rise, largest_fall);
+
+  return checkResult("governor");
+}
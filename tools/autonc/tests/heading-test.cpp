@@ -0,0 +1,41 @@
+// headingLoop with the chassis still: gyro bias is learned and the heading held, but the
+// robot being pushed around (rotation faster than the bias limit) is still a turn.
+
+#include "vex.h"
+#include "heading.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+// Push: the robot is turned this far with the wheels still, starting at push_start_msec (in degrees, msec)
+const double push_deg = 30, push_start_msec = 2000, push_msec = 500;
+
+/*
+ * Turns the robot in place without driving it, as a robot pushed by another would.
+ */
+void pushRobot() {
+  double progress = (sim_time_msec - push_start_msec) / push_msec;
+  if (progress > 0 && progress <= 1) {
+    double x, y, heading_deg;
+    simulationPose(x, y, heading_deg);
+    placeSimulation(x, y, push_deg * progress);
+  }
+}
+
+int main() {
+  // Still with a drifting gyro: the bias is learned and the heading held
+  resetSimulation(0, 0, 0);
+  sim_gyro_bias_dps = 0.5;
+  simRunTask(headingLoop, 4000);
+  CHECK_NEAR(getHeadingBias(), 0.5, 0.1);
+  CHECK_NEAR(getCorrectedHeading(), 0, 0.3);
+  sim_gyro_bias_dps = 0;
+
+  // Still, then pushed 30 degrees: the push is integrated, not dropped as bias
+  resetSimulation(0, 0, 0);
+  sim_step_hook = pushRobot;
+  simRunTask(headingLoop, 4000);
+  sim_step_hook = 0;
+  CHECK_NEAR(getCorrectedHeading(), push_deg, 0.5);
+
+  return checkResult("heading");
+}
@@ -0,0 +1,133 @@
+// Localization against the field walls on a simulated run: odometry that over-reads and
+// starts off the true pose, four distance sensors with range noise and occasional short
+// readings (game objects), and the filter has to bring x_pos/y_pos back to the truth.
+
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "localization.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+#include <stdint.h>
+
+// Length of the run (in milliseconds)
+const double run_msec = 6000;
+// Start pose and how far off the filter and odometry are told it is (in inches)
+const double start_x = -24, start_y = -30;
+const double start_error_x = 5, start_error_y = -4;
+// Odometry distance error (fraction of the distance traveled)
+const double odometry_scale_error = 0.04;
+// Range noise (in inches and fraction of the range) and share of short readings
+const double range_noise_in = 0.5, range_noise_ratio = 0.02, short_reading_rate = 0.02;
+
+vex::distance front_sensor(1), right_sensor(2), back_sensor(3), left_sensor(4);
+
+struct Mount {
+  vex::distance* sensor;
+  double offset_x, offset_y, angle_deg;
+};
+Mount mounts[4] = {
+  { &front_sensor, 0, 6, 0 },
+  { &right_sensor, 6, 0, 90 },
+  { &back_sensor, 0, -6, 180 },
+  { &left_sensor, -6, 0, 270 },
+};
+
+uint64_t noise_bits = 88172645463325252ull;
+double prev_true_x, prev_true_y;
+
+// xorshift64, uniform in [0, 1)
+double noiseUniform() {
+  noise_bits ^= noise_bits << 13;
+  noise_bits ^= noise_bits >> 7;
+  noise_bits ^= noise_bits << 17;
+  return (noise_bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Approximately normal with unit variance (sum of twelve uniforms)
+double noiseGaussian() {
+  double sum = 0;
+  for (int i = 0; i < 12; i++) sum += noiseUniform();
+  return sum - 6;
+}
+
+/*
+ * Distance from a point to the field perimeter along a direction (clockwise from +y, in inches).
+ */
+double distanceToWall(double x, double y, double direction_rad) {
+  double beam_x = sin(direction_rad), beam_y = cos(direction_rad);
+  double t_x = fabs(beam_x) > 1e-9 ? ((beam_x > 0 ? 72 : -72) - x) / beam_x : 1e9;
+  double t_y = fabs(beam_y) > 1e-9 ? ((beam_y > 0 ? 72 : -72) - y) / beam_y : 1e9;
+  return fmin(t_x, t_y);
+}
+
+/*
+ * Drives forward, turns right and drives on, then stops. Every step the distance sensors
+ * read the walls from the true pose and odometry adds the true motion, over-read, to x_pos/y_pos.
+ */
+void wallRun() {
+  double t = sim_time_msec / 1000;
+  double turn = t > 1.5 && t < 2.2 ? 3 : 0;
+  double drive = t < 4.5 ? 5 : 0;
+  left_chassis.volts = drive + turn;
+  right_chassis.volts = drive - turn;
+
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  double heading_rad = degToRad(heading_deg);
+  for (int i = 0; i < 4; i++) {
+    const Mount& mount = mounts[i];
+    double sensor_x = x + mount.offset_x * cos(heading_rad) + mount.offset_y * sin(heading_rad);
+    double sensor_y = y - mount.offset_x * sin(heading_rad) + mount.offset_y * cos(heading_rad);
+    double range = distanceToWall(sensor_x, sensor_y, heading_rad + degToRad(mount.angle_deg));
+    range += noiseGaussian() * (range_noise_in + range_noise_ratio * range);
+    if (noiseUniform() < short_reading_rate) {
+      range *= noiseUniform();
+    }
+    mount.sensor->distance_mm = range * 25.4;
+  }
+
+  x_pos += (x - prev_true_x) * (1 + odometry_scale_error);
+  y_pos += (y - prev_true_y) * (1 + odometry_scale_error);
+  prev_true_x = x;
+  prev_true_y = y;
+}
+
+/*
+ * Runs the drive with the filter on or off. Returns the distance between x_pos/y_pos and
+ * the true pose at the end (in inches).
+ */
+double runWithLocalization(bool enabled) {
+  resetSimulation(start_x, start_y, 0);
+  sim_odometry = true;
+  prev_true_x = start_x;
+  prev_true_y = start_y;
+  resetLocalization(start_x + start_error_x, start_y + start_error_y, 6);
+  setLocalizationEnabled(enabled);
+  sim_step_hook = wallRun;
+  simRunTask(localizationLoop, run_msec);
+  sim_step_hook = 0;
+  sim_odometry = false;
+  setLocalizationEnabled(false);
+
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  CHECK(!simulationHitWall());
+  CHECK(hypot(x - start_x, y - start_y) > 30);
+  return hypot(x_pos - x, y_pos - y);
+}
+
+int main() {
+  for (int i = 0; i < 4; i++) {
+    addLocalizationSensor(*mounts[i].sensor, mounts[i].offset_x, mounts[i].offset_y, mounts[i].angle_deg);
+  }
+
+  double odometry_error = runWithLocalization(false);
+  double filtered_error = runWithLocalization(true);
+  printf("localization: error after the run, odometry %.2f in, filtered %.2f in\n", odometry_error, filtered_error);
+  CHECK(odometry_error > 5);
+  CHECK(filtered_error < 1);
+
+  return checkResult("localization");
+}
@@ -0,0 +1,91 @@
+// Motion primitives on runControlLoop: each one is run in the chassis simulation from the same
+// start and its end pose and exit tick are checked against fixed values, so a change to the
+// shared loop or to a primitive's policies shows up here. After an intended behaviour change,
+// run build/motion-test print and paste the new table.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "trajectory.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+#include <string.h>
+
+Trajectory trajectory;
+
+void turnRight() { turnToAngle(90, 2000); }
+void driveForward() { driveTo(24, 2000); }
+void driveBack() { driveTo(-18, 2000); }
+void curveRight() { curveCircle(90, 24, 3000); }
+void swingRight() { swing(60, 1, 2000); }
+void facePoint() { turnToPoint(24, 24, 1, 2000); }
+void movePoint() { moveToPoint(24, 24, 1, 3000); }
+void movePointBack() { moveToPoint(-12, -24, -1, 3000); }
+void boomerangPose() { boomerang(24, 36, 1, 0, 0.5, 3000); }
+void arcRight() { arcTo(90, 24, 3000); }
+void swingToLeft() { swingTo(-45, 1, 2000); }
+// Chained into driveTo, which is the motion checked
+void chainMoveDrive() {
+  moveToPoint(0, 24, 1, 2000, false);
+  driveTo(12, 2000);
+}
+void followPath() {
+  double xs[] = { 0, 0, 24, 24 }, ys[] = { 0, 24, 36, 60 };
+  generateTrajectory(trajectory, xs, ys, 4, 40, 80, 60);
+  followTrajectory(trajectory, 1, 5000);
+}
+void driveTimeLimit() { driveTo(48, 300); }
+
+struct Motion {
+  const char* name;
+  void (*run)();
+  double x, y, heading_deg; // End pose (inches, degrees)
+  int ticks;                // last_motion.ticks
+  bool timed_out;
+};
+
+// Each motion starts at (0, 0) facing 0 degrees. The end poses and ticks of the single motions
+// match the loops before runControlLoop; the chained driveTo ends one tick earlier by design.
+Motion motions[] = {
+  { "turnRight", turnRight, 0.000, 0.000, 89.58, 52, false },
+  { "driveForward", driveForward, 0.000, 24.607, 0.00, 70, false },
+  { "driveBack", driveBack, 0.000, -18.664, 0.00, 61, false },
+  { "curveRight", curveRight, 23.959, 24.000, 89.90, 116, false },
+  { "swingRight", swingRight, 3.030, 5.300, 59.51, 62, false },
+  { "facePoint", facePoint, 0.000, 0.000, 44.76, 48, false },
+  { "movePoint", movePoint, 23.268, 23.448, 53.47, 77, false },
+  { "movePointBack", movePointBack, -11.563, -23.290, 33.17, 64, false },
+  { "boomerangPose", boomerangPose, 23.445, 31.337, 5.43, 86, false },
+  { "arcRight", arcRight, 24.396, 23.997, 90.95, 102, false },
+  { "swingToLeft", swingToLeft, -1.874, 4.420, -45.95, 58, false },
+  { "chainMoveDrive", chainMoveDrive, 0.000, 35.500, 0.00, 34, false },
+  { "followPath", followPath, 23.813, 59.651, 10.63, 278, false },
+  { "driveTimeLimit", driveTimeLimit, 0.000, 16.055, 0.00, 31, true },
+};
+
+int main(int argc, char** argv) {
+  bool print = argc > 1 && strcmp(argv[1], "print") == 0;
+  for (unsigned i = 0; i < sizeof(motions) / sizeof(motions[0]); i++) {
+    Motion& motion = motions[i];
+    resetSimulation(0, 0, 0);
+    motion.run();
+    double x, y, heading_deg;
+    simulationPose(x, y, heading_deg);
+    if (print) {
+      printf("  { \"%s\", %s, %.3f, %.3f, %.2f, %d, %s },\n", motion.name, motion.name, x, y, heading_deg,
+             last_motion.ticks, last_motion.timed_out ? "true" : "false");
+      continue;
+    }
+    int failures_before = check_failures;
+    CHECK(!simulationHitWall());
+    CHECK_NEAR(x, motion.x, 0.01);
+    CHECK_NEAR(y, motion.y, 0.01);
+    CHECK_NEAR(heading_deg, motion.heading_deg, 0.05);
+    CHECK(last_motion.ticks == motion.ticks);
+    CHECK(last_motion.timed_out == motion.timed_out);
+    if (check_failures > failures_before) {
+      printf("motion: %s ended at (%.3f, %.3f) %.2f deg after %d ticks\n", motion.name, x, y, heading_deg, last_motion.ticks);
+    }
+  }
+  return print ? 0 : checkResult("motion");
+}
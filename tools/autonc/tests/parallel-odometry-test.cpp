@@ -0,0 +1,68 @@
+// Accuracy of trackParallelOdomWheel (heading from the two vertical trackers, filtered
+// against the inertial sensor) against trackXYOdomWheel (inertial heading): both replay
+// the same 60 s simulated run with the same sensor errors.
+
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+// Length of the run (in milliseconds)
+const double run_msec = 60000;
+
+struct SensorErrors {
+  const char* name;
+  double gyro_bias_dps, gyro_noise_deg, tracker_scrub;
+};
+
+/*
+ * Replays the run through a tracker with the given sensor errors. Returns the position
+ * error at the end (in inches).
+ */
+double replay(void (*tracker)(), const SensorErrors& errors) {
+  resetSimulation(0, 0, 0);
+  sim_gyro_bias_dps = errors.gyro_bias_dps;
+  sim_gyro_noise_deg = errors.gyro_noise_deg;
+  sim_tracker_scrub = errors.tracker_scrub;
+  sim_odometry = true;
+  sim_step_hook = simSkillsDrive;
+  simRunTask(tracker, run_msec);
+  sim_step_hook = 0;
+  sim_odometry = false;
+  sim_gyro_bias_dps = sim_gyro_noise_deg = sim_tracker_scrub = 0;
+  stopChassis();
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  return hypot(x_pos - x, y_pos - y);
+}
+
+int main() {
+  using_horizontal_tracker = true;
+  SensorErrors runs[] = {
+    { "exact sensors", 0, 0, 0 },
+    { "gyro noise 0.3 deg", 0, 0.3, 0 },
+    { "gyro drift 0.02 deg/s", 0.02, 0, 0 },
+    { "tracker scrub 2%", 0, 0, 0.02 },
+  };
+  const int run_count = sizeof(runs) / sizeof(runs[0]);
+  double xy_error[run_count], parallel_error[run_count];
+
+  printf("parallel-odometry: position error after a %.0f s run      XY  parallel\n", run_msec / 1000);
+  for (int i = 0; i < run_count; i++) {
+    xy_error[i] = replay(trackXYOdomWheel, runs[i]);
+    parallel_error[i] = replay(trackParallelOdomWheel, runs[i]);
+    printf("  %-24s %29.3f %9.3f in\n", runs[i].name, xy_error[i], parallel_error[i]);
+  }
+
+  // Exact sensors: both track the run
+  CHECK(xy_error[0] < 0.02 && parallel_error[0] < 0.02);
+  // Gyro noise: the wheel heading smooths it
+  CHECK(parallel_error[1] <= xy_error[1]);
+  // Gyro drift: the inertial sensor still sets the long-term heading, as it does for trackXYOdomWheel
+  CHECK_NEAR(parallel_error[2], xy_error[2], 0.2 * xy_error[2]);
+  // Tracker scrub: the inertial sensor keeps the wheel heading from running away
+  CHECK(parallel_error[3] < 1);
+
+  return checkResult("parallel-odometry");
+}
@@ -0,0 +1,85 @@
+// Path planner around a wall that needs two turns to pass: the planned path must keep the
+// robot radius from the wall, and a waypoint limit too small for it must fail rather than
+// return (or cache) a truncated path through the wall. With the gap closed there is no
+// path, and moveToPointPlanned must leave the robot where it is.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "path-planner.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+// The wall, with a gap near the far field wall
+const double wall_x1 = -4, wall_y1 = -72, wall_x2 = 4, wall_y2 = 40;
+const double robot_radius = 9;
+
+/*
+ * Smallest distance between the wall and the straight path between two points (in inches).
+ */
+double clearance(double x1, double y1, double x2, double y2) {
+  double closest = 1e9;
+  for (int i = 0; i <= 1000; i++) {
+    double t = i / 1000.0;
+    double x = x1 + (x2 - x1) * t, y = y1 + (y2 - y1) * t;
+    double dx = fmax(fmax(wall_x1 - x, 0.0), x - wall_x2);
+    double dy = fmax(fmax(wall_y1 - y, 0.0), y - wall_y2);
+    closest = fmin(closest, hypot(dx, dy));
+  }
+  return closest;
+}
+
+/*
+ * Whether a planned path from (start_x, start_y) keeps the robot radius from the wall,
+ * less the grid resolution.
+ */
+bool pathClear(double start_x, double start_y, double* xs, double* ys, int count) {
+  double x = start_x, y = start_y;
+  for (int i = 0; i < count; i++) {
+    if (clearance(x, y, xs[i], ys[i]) < robot_radius - FIELD_CELL_IN) {
+      return false;
+    }
+    x = xs[i];
+    y = ys[i];
+  }
+  return true;
+}
+
+int main() {
+  double xs[MAX_PATH_WAYPOINTS], ys[MAX_PATH_WAYPOINTS];
+  clearFieldObstacles();
+  setPlannerRobotRadius(robot_radius);
+  addFieldObstacle(wall_x1, wall_y1, wall_x2, wall_y2);
+
+  // Too few waypoints to get around the wall
+  CHECK(planPath(-30, 0, 30, 0, xs, ys, 2) == 0);
+
+  // Enough waypoints: the path ends at the goal and stays clear of the wall
+  int count = planPath(-30, 0, 30, 0, xs, ys);
+  CHECK(count >= 3);
+  if (count > 0) {
+    CHECK_NEAR(xs[count - 1], 30, 1e-9);
+    CHECK_NEAR(ys[count - 1], 0, 1e-9);
+    CHECK(pathClear(-30, 0, xs, ys, count));
+  }
+
+  // The cached path is not handed out truncated either
+  CHECK(planPath(-30, 0, 30, 0, xs, ys, 2) == 0);
+  CHECK(planPath(-30, 0, 30, 0, xs, ys) == count);
+
+  // A goal in plain sight needs no waypoint limit beyond the goal itself
+  CHECK(planPath(-30, -20, -30, 20, xs, ys, 1) == 1);
+
+  // Gap closed: no path, and the robot is not driven into the wall
+  addFieldObstacle(wall_x1, wall_y2, wall_x2, 72);
+  CHECK(planPath(-30, 0, 30, 0, xs, ys) == 0);
+  resetSimulation(-30, 0, 90);
+  double start_msec = sim_time_msec;
+  CHECK(!moveToPointPlanned(30, 0, 1, 3000));
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  CHECK_NEAR(x, -30, 1e-9);
+  CHECK_NEAR(y, 0, 1e-9);
+  CHECK_NEAR(sim_time_msec, start_msec, 1e-9);
+
+  return checkResult("path-planner");
+}
@@ -0,0 +1,33 @@
+// Pose history with odometry sub-steps: the trackers record one pose per 10 msec whatever
+// odom_substeps is, so the history still reaches 1.28 s back for latency compensation.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "heading.h"
+#include "pose-history.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+int main() {
+  for (int substeps = 1; substeps <= 10; substeps += 9) {
+    odom_substeps = substeps;
+    clearPoseHistory();
+    resetSimulation(0, 0, 0);
+    sim_odometry = true;
+    sim_step_hook = simSkillsDrive;
+    void (*tasks[])() = { headingLoop, trackXYOdomWheel };
+    simRunTasks(tasks, 2, 3000);
+    sim_step_hook = 0;
+    sim_odometry = false;
+    stopChassis();
+
+    // The oldest pose is POSE_HISTORY_SIZE steps of 10 msec back
+    PoseSample pose;
+    double latest_msec = predictPose(sim_time_msec, 0).time_msec;
+    CHECK(poseAt(latest_msec - (POSE_HISTORY_SIZE - 1) * 10 + 1, pose));
+    CHECK(!poseAt(latest_msec - (POSE_HISTORY_SIZE + 1) * 10, pose));
+  }
+  odom_substeps = 1;
+
+  return checkResult("pose-history");
+}
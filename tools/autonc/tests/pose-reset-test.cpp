@@ -0,0 +1,70 @@
+// Pose reset while odometry runs: the gyro drifts 20 degrees during a drive, then the
+// routine resets the pose to the truth (setPose, squaring on a wall) and drives on. Each
+// tracker runs with headingLoop and has to continue from the reset pose, without turning
+// the heading jump into a phantom arc or easing toward the new heading.
+
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "heading.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+// Drive length, and when the pose is reset (in milliseconds)
+const double run_msec = 4000, reset_msec = 2000;
+// Gyro drift before the reset (in degrees per second)
+const double drift_dps = 10;
+
+/*
+ * Drives a gentle curve, stopping for the last half second, and resets the pose to the
+ * true one at reset_msec, as setPose does.
+ */
+void curveAndReset() {
+  bool driving = sim_time_msec < run_msec - 500;
+  left_chassis.volts = driving ? 4.5 : 0;
+  right_chassis.volts = driving ? 3.5 : 0;
+  if (sim_time_msec >= reset_msec && sim_gyro_bias_dps != 0) {
+    sim_gyro_bias_dps = 0;
+    double x, y, heading_deg;
+    simulationPose(x, y, heading_deg);
+    resetOdometryHeading(heading_deg);
+    x_pos = x;
+    y_pos = y;
+  }
+}
+
+/*
+ * Drives through the reset with a tracker and headingLoop. Returns the position error at
+ * the end (in inches).
+ */
+double driveThroughReset(void (*tracker)()) {
+  resetSimulation(-24, -48, 0);
+  sim_gyro_bias_dps = drift_dps;
+  sim_odometry = true;
+  sim_step_hook = curveAndReset;
+  void (*tasks[])() = { headingLoop, tracker };
+  simRunTasks(tasks, 2, run_msec);
+  sim_step_hook = 0;
+  sim_odometry = false;
+  sim_gyro_bias_dps = 0;
+  stopChassis();
+
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  CHECK(!simulationHitWall());
+  CHECK_NEAR(getCorrectedHeading(), heading_deg, 0.05);
+  return hypot(x_pos - x, y_pos - y);
+}
+
+int main() {
+  using_horizontal_tracker = true;
+  printf("pose-reset: position error %.0f s after a %.0f degree heading reset\n", (run_msec - reset_msec) / 1000, drift_dps * reset_msec / 1000);
+  const char* names[] = { "trackNoOdomWheel", "trackXYOdomWheel", "trackXOdomWheel", "trackYOdomWheel", "trackParallelOdomWheel" };
+  void (*trackers[])() = { trackNoOdomWheel, trackXYOdomWheel, trackXOdomWheel, trackYOdomWheel, trackParallelOdomWheel };
+  for (int i = 0; i < 5; i++) {
+    double error = driveThroughReset(trackers[i]);
+    printf("  %-24s %8.4f in\n", names[i], error);
+    CHECK(error < 0.01);
+  }
+  return checkResult("pose-reset");
+}
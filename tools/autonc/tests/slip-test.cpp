@@ -0,0 +1,88 @@
+// Wheel-slip detection with drive encoders at the V5's 1.2 degree resolution and odometry
+// from the encoders and inertial sensor (trackNoOdomWheel): normal driving must not count as
+// slip, and pushing against a wall with the wheels spinning must not count as travel, both
+// at the default loop rate and with odom_substeps = 10.
+
+#include "vex.h"
+#include "utils.h"
+#include "motor-control.h"
+#include "heading.h"
+#include "slip.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+// Normal driving: drives around the field center for drive_msec (in milliseconds)
+const double drive_msec = 20000;
+// Wall push: starts wall_start_y from the field center facing the wall and drives into it
+// for push_msec (in inches, milliseconds)
+const double wall_start_y = 40, push_msec = 3000;
+
+bool slipped = false;
+
+void watchSlip() {
+  slipped = slipped || isSlipping();
+}
+
+// Each run stops for its last half second, so the next starts from rest as the robot would
+void driveAround() {
+  simSkillsDrive();
+  if (sim_time_msec >= drive_msec) {
+    left_chassis.volts = right_chassis.volts = 0;
+  }
+  watchSlip();
+}
+
+void pushWall() {
+  bool driving = sim_time_msec < push_msec;
+  left_chassis.volts = right_chassis.volts = driving ? 8 : 0;
+  watchSlip();
+}
+
+/*
+ * Runs trackNoOdomWheel and headingLoop with a step hook from (0, start_y) facing the far wall.
+ * Returns the position error at the end (in inches).
+ */
+double run(void (*hook)(), double start_y, double run_msec) {
+  resetSimulation(0, start_y, 0);
+  slipped = false;
+  sim_odometry = true;
+  sim_step_hook = hook;
+  void (*tasks[])() = { headingLoop, trackNoOdomWheel };
+  simRunTasks(tasks, 2, run_msec);
+  sim_step_hook = 0;
+  sim_odometry = false;
+  stopChassis();
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  return hypot(x_pos - x, y_pos - y);
+}
+
+int main() {
+  sim_encoder_deg = 1.2;
+  sim_wall_slip = true;
+  printf("slip: position error          normal driving  wall push\n");
+  for (int substeps = 1; substeps <= 10; substeps += 9) {
+    odom_substeps = substeps;
+
+    // Normal driving: no slip, the encoders are trusted
+    double slip_before = getSlipDistance();
+    double driving_error = run(driveAround, 0, drive_msec + 500);
+    CHECK(!slipped);
+    CHECK(!simulationHitWall());
+    CHECK_NEAR(getSlipDistance(), slip_before, 1e-9);
+    CHECK(driving_error < 0.5);
+
+    // Wall push: the spinning wheels are slip, and the travel they count is dropped
+    double pushing_error = run(pushWall, wall_start_y, push_msec + 500);
+    CHECK(simulationHitWall());
+    CHECK(slipped);
+    CHECK(!isSlipping());
+    CHECK(pushing_error < 3);
+    printf("  odom_substeps %-2d %20.3f %10.3f in\n", substeps, driving_error, pushing_error);
+  }
+  odom_substeps = 1;
+  sim_encoder_deg = 0;
+  sim_wall_slip = false;
+
+  return checkResult("slip");
+}
@@ -0,0 +1,51 @@
+// Trajectory sampling limit: a path that needs more than MAX_TRAJECTORY_POINTS samples must
+// fail and leave the trajectory empty, so followTrajectory does not stop the robot short of the
+// goal; one that fits ends exactly on the last waypoint.
+
+#include "vex.h"
+#include "motor-control.h"
+#include "trajectory.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+Trajectory trajectory;
+
+/*
+ * Samples a straight path length_in long (in inches) at spacing_in. Returns generateTrajectory's result.
+ */
+double straightPath(double length_in, double spacing_in) {
+  double xs[] = { 0, 0 }, ys[] = { 0, length_in };
+  return generateTrajectory(trajectory, xs, ys, 2, 60, 120, 100, 0, 0, spacing_in);
+}
+
+int main() {
+  // Fits: starts and ends on the waypoints, at rest
+  CHECK(straightPath(200, 1) > 0);
+  CHECK(trajectory.count == 201);
+  CHECK_NEAR(trajectory.y[trajectory.count - 1], 200, 1e-9);
+  CHECK_NEAR(trajectory.velocity[trajectory.count - 1], 0, 1e-9);
+
+  // Exactly MAX_TRAJECTORY_POINTS samples, then one more for the end point
+  CHECK(straightPath(MAX_TRAJECTORY_POINTS - 1, 1) > 0);
+  CHECK(trajectory.count == MAX_TRAJECTORY_POINTS);
+  CHECK(straightPath(MAX_TRAJECTORY_POINTS - 0.5, 1) < 0);
+  CHECK(trajectory.count == 0);
+
+  // Too long at 1 inch: fails instead of stopping at 300 inches
+  CHECK(straightPath(400, 1) < 0);
+  CHECK(trajectory.count == 0);
+
+  // followTrajectory leaves the robot where it is
+  resetSimulation(0, 0, 0);
+  followTrajectory(trajectory, 1, 3000);
+  double x, y, heading_deg;
+  simulationPose(x, y, heading_deg);
+  CHECK_NEAR(x, 0, 1e-9);
+  CHECK_NEAR(y, 0, 1e-9);
+
+  // The same path at a wider spacing fits
+  CHECK(straightPath(400, 2) > 0);
+  CHECK_NEAR(trajectory.y[trajectory.count - 1], 400, 1e-9);
+
+  return checkResult("trajectory");
+}
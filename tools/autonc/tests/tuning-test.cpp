@@ -0,0 +1,109 @@
+// Live tuning console over USB serial: commands are typed into one side of a pty, tuningLoop
+// reads them through vexSerialReadChar from the other side and its replies come back the same
+// way, as they would on a laptop's serial terminal.
+
+#include "vex.h"
+#include "config-store.h"
+#include "tuning.h"
+#include "sim/chassis-sim.h"
+#include "tests/check.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Laptop side of the pty, and the replies read from it so far
+int terminal_fd = -1;
+char replies[16384];
+size_t replies_length = 0;
+
+/*
+ * Reads whatever tuningLoop has written so far, so the pty never fills up.
+ */
+void readReplies() {
+  ssize_t count;
+  while (replies_length < sizeof(replies) - 1 &&
+         (count = read(terminal_fd, replies + replies_length, sizeof(replies) - 1 - replies_length)) > 0) {
+    replies_length += count;
+  }
+  replies[replies_length] = 0;
+}
+
+/*
+ * Number of reply lines starting with prefix.
+ */
+int countReplies(const char* prefix) {
+  int count = 0;
+  for (const char* line = replies; *line; line = strchr(line, '\n') + 1) {
+    if (strncmp(line, prefix, strlen(prefix)) == 0) {
+      count++;
+    }
+    if (!strchr(line, '\n')) {
+      break;
+    }
+  }
+  return count;
+}
+
+int main() {
+  // A raw pty pair: no echo and no newline translation, like the V5's USB serial port
+  terminal_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  CHECK(terminal_fd >= 0 && grantpt(terminal_fd) == 0 && unlockpt(terminal_fd) == 0);
+  int robot_fd = open(ptsname(terminal_fd), O_RDWR | O_NOCTTY);
+  CHECK(robot_fd >= 0);
+  termios raw;
+  tcgetattr(robot_fd, &raw);
+  cfmakeraw(&raw);
+  tcsetattr(robot_fd, TCSANOW, &raw);
+  fcntl(terminal_fd, F_SETFL, O_NONBLOCK);
+
+  const char* commands =
+    "list\n"
+    "get turn_kp\r\n"
+    "set turn_kp 2.5\n"
+    "set turn_kp 250\n"
+    "set turn_kp fast\n"
+    "get no_such_tunable\n"
+    "spin\n"
+    "set turn_kp 0.0000000000000000000000000000000000000000000000000000000001\n";
+  CHECK(write(terminal_fd, commands, strlen(commands)) == (ssize_t)strlen(commands));
+
+  // tuningLoop replies on stdout, which is the serial port on the V5
+  fflush(stdout);
+  int saved_stdout = dup(STDOUT_FILENO);
+  dup2(robot_fd, STDOUT_FILENO);
+  sim_serial_fd = robot_fd;
+  sim_step_hook = readReplies;
+  simRunTask(tuningLoop, 200);
+  sim_step_hook = 0;
+  sim_serial_fd = -1;
+  fflush(stdout);
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(saved_stdout);
+  readReplies();
+
+  // list: one line per tunable, then the count
+  char list_end[32];
+  snprintf(list_end, sizeof(list_end), "ok %d\n", getConfigCount());
+  CHECK(strstr(replies, list_end) != 0);
+  CHECK(strstr(replies, "turn_kp ") == replies || strstr(replies, "\nturn_kp ") != 0);
+
+  // get and set
+  CHECK(countReplies("ok turn_kp = ") == 2);
+  CHECK(strstr(replies, "ok turn_kp = 2.5\n") != 0);
+  // Out of range and not a number: rejected, the value kept
+  CHECK(countReplies("error turn_kp takes 0 to 100\n") == 2);
+  CHECK_NEAR(turn_kp, 2.5, 1e-12);
+  CHECK(countReplies("error unknown tunable\n") == 1);
+  CHECK(countReplies("error unknown command\n") == 1);
+  // A line longer than the buffer is dropped whole
+  CHECK(countReplies("error line too long\n") == 1);
+  // Every command got exactly one ok or error line
+  CHECK(countReplies("ok ") + countReplies("error ") == 8);
+
+  close(robot_fd);
+  close(terminal_fd);
+  return checkResult("tuning");
+}